@@ -0,0 +1,124 @@
+/*!
+ * Benchmark: loading assets from loose files versus from the packed archive (see AssetArchive).
+ *
+ * Packs the graphics, sounds and fonts into a temporary archive, then measures (median of
+ * `runs` runs, with an empty GameCache every time):
+ * - startup: the fonts and the UI textures loaded before the first level;
+ * - level: the assets of the level's manifest (see LevelSet::getAssetManifest).
+ * With the archive, the startup time includes mapping it. Files are read through the OS
+ * page cache in both cases, so this measures the per-file overhead, not cold disk reads.
+ *
+ * Usage: bench_asset_archive [levelset.json] [level] [runs]
+ */
+#include "AssetArchive.hpp"
+#include "GameCache.hpp"
+#include "LevelSet.hpp"
+#include "MusicManager.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double median(std::vector<double> v) {
+	std::sort(v.begin(), v.end());
+	return v[v.size() / 2];
+}
+
+const std::vector<std::string> UI_TEXTURES = {
+	"screenbg1.png", "panel.png", "playerheads.png", "health.png", "extra_icons.png", "bonuses.png",
+	"speaker.png", "hurryup.png", "gameover.png", "extragame.png"
+};
+
+void loadStartupAssets() {
+	for (const auto& font : {
+		lif::fonts::SCREEN, lif::fonts::SIDE_PANEL, lif::fonts::SIDE_PANEL_THIN,
+		lif::fonts::INTERLEVEL, lif::fonts::POINTS, lif::fonts::CUTSCENES
+	})
+		lif::cache.loadFont(lif::getAsset("fonts", font));
+	for (const auto& name : UI_TEXTURES)
+		lif::cache.loadTexture(lif::getAsset("graphics", name));
+}
+
+void loadLevelAssets(const lif::AssetManifest& manifest) {
+	for (const auto& name : manifest.textures)
+		lif::cache.loadTexture(name);
+	for (const auto& name : manifest.sounds) {
+		sf::Sound sound;
+		lif::cache.loadSound(sound, name);
+	}
+}
+
+}
+
+int main(int argc, char **argv) {
+	const std::string levelsetName = argc > 1 ? argv[1] : "levels.json";
+	const int levelnum = argc > 2 ? std::atoi(argv[2]) : 1;
+	const int runs = argc > 3 ? std::max(1, std::atoi(argv[3])) : 20;
+
+	lif::MusicManager mm;
+	lif::musicManager = &mm;
+	if (!lif::init()) {
+		std::cerr << "Failed to initialize the game!" << std::endl;
+		return 1;
+	}
+	// Start from the loose files even if the game's archive exists
+	lif::cache.finalize();
+
+	// Creates the GL context needed to upload the textures
+	sf::RenderTexture context;
+	context.create(1, 1);
+
+	lif::LevelSet ls;
+	if (!ls.loadFromFile(levelsetName) || levelnum < 1 || levelnum > ls.getLevelsNum()) {
+		std::cerr << "Failed to load level " << levelnum << " of " << levelsetName << std::endl;
+		return 1;
+	}
+	const auto manifest = ls.getAssetManifest(levelnum);
+
+	const std::string archivePath = std::string(lif::pwd) + lif::DIRSEP + "bench_assets.pak";
+	auto start = Clock::now();
+	if (!lif::AssetArchive::pack(lif::getAssetDir(), { "graphics", "sounds", "fonts" }, archivePath)) {
+		std::cerr << "Failed to pack the assets" << std::endl;
+		return 1;
+	}
+	const auto packTime = msSince(start);
+
+	std::vector<double> startup[2], level[2];
+	for (int r = 0; r < runs; ++r) {
+		for (int packed = 0; packed < 2; ++packed) {
+			start = Clock::now();
+			if (packed)
+				lif::cache.openArchive(archivePath, lif::getAssetDir());
+			loadStartupAssets();
+			startup[packed].emplace_back(msSince(start));
+
+			start = Clock::now();
+			loadLevelAssets(manifest);
+			level[packed].emplace_back(msSince(start));
+
+			lif::cache.finalize();
+		}
+	}
+	std::remove(archivePath.c_str());
+
+	std::cout << std::fixed << std::setprecision(3)
+		<< "packed the assets in " << packTime << " ms; median of " << runs << " runs, ms:\n"
+		<< std::setw(8) << "" << std::setw(10) << "startup" << std::setw(10) << "level" << "\n"
+		<< std::setw(8) << "loose" << std::setw(10) << median(startup[0]) << std::setw(10) << median(level[0]) << "\n"
+		<< std::setw(8) << "packed" << std::setw(10) << median(startup[1]) << std::setw(10) << median(level[1]) << "\n";
+
+	return 0;
+}
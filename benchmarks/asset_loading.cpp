@@ -0,0 +1,133 @@
+/*!
+ * Benchmark: frame hitches caused by loading assets the first time they're used, with the
+ * synchronous GameCache::loadTexture/loadSound versus prefetching them all at level start
+ * and uploading them with GameCache::uploadPending.
+ *
+ * The assets are those of the level's manifest (see LevelSet::getAssetManifest).
+ * Runs `frames` frames at 60 FPS; the textures and sounds are first used at evenly spaced
+ * frames. Only the time spent in the GameCache is measured: a frame "hitches" by that much.
+ *
+ * Usage: bench_asset_loading [levelset.json] [level] [frames]
+ */
+#include "GameCache.hpp"
+#include "LevelSet.hpp"
+#include "MusicManager.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Asset {
+	std::string name;
+	bool isTexture;
+};
+
+double msSince(Clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void useAsset(const Asset& asset) {
+	if (asset.isTexture) {
+		lif::cache.loadTexture(asset.name);
+	} else {
+		sf::Sound sound;
+		lif::cache.loadSound(sound, asset.name);
+	}
+}
+
+/** @return The time spent loading assets in each frame */
+std::vector<double> run(const std::vector<Asset>& assets, const lif::AssetManifest& manifest,
+		int frames, bool async)
+{
+	const auto framePeriod = std::chrono::microseconds(16667);
+	const auto spacing = std::max(1, frames / int(assets.size() + 1));
+	std::vector<double> times;
+	times.reserve(frames);
+	for (int f = 0; f < frames; ++f) {
+		const auto frameStart = Clock::now();
+		if (async && f == 0)
+			manifest.prefetch();
+		const auto i = f / spacing - 1;
+		if (f % spacing == 0 && i >= 0 && i < int(assets.size()))
+			useAsset(assets[i]);
+		if (async)
+			lif::cache.uploadPending(sf::milliseconds(2));
+		times.emplace_back(msSince(frameStart));
+		std::this_thread::sleep_until(frameStart + framePeriod);
+	}
+	// Drop all the loaded assets
+	lif::cache.finalize();
+	return times;
+}
+
+void report(const char *name, std::vector<double> times) {
+	std::sort(times.begin(), times.end());
+	const auto pct = [&times] (double p) { return times[std::min(times.size() - 1, std::size_t(p * times.size()))]; };
+	const auto over = std::count_if(times.begin(), times.end(), [] (double t) { return t > 4; });
+	std::cout << std::setw(6) << name
+		<< std::setw(10) << pct(0.5) << std::setw(10) << pct(0.95) << std::setw(10) << pct(0.99)
+		<< std::setw(10) << times.back() << std::setw(10) << over << "\n";
+}
+
+}
+
+int main(int argc, char **argv) {
+	const std::string levelsetName = argc > 1 ? argv[1] : "levels.json";
+	const int levelnum = argc > 2 ? std::atoi(argv[2]) : 1;
+	const int frames = argc > 3 ? std::atoi(argv[3]) : 300;
+
+	lif::MusicManager mm;
+	lif::musicManager = &mm;
+	if (!lif::init()) {
+		std::cerr << "Failed to initialize the game!" << std::endl;
+		return 1;
+	}
+
+	// Creates the GL context needed to upload the textures
+	sf::RenderTexture context;
+	context.create(1, 1);
+
+	lif::LevelSet ls;
+	if (!ls.loadFromFile(levelsetName) || levelnum < 1 || levelnum > ls.getLevelsNum()) {
+		std::cerr << "Failed to load level " << levelnum << " of " << levelsetName << std::endl;
+		return 1;
+	}
+	const auto manifest = ls.getAssetManifest(levelnum);
+
+	std::vector<Asset> assets;
+	for (const auto& name : manifest.textures)
+		assets.push_back({ name, true });
+	for (const auto& name : manifest.sounds)
+		assets.push_back({ name, false });
+	for (const auto& asset : assets)
+		if (!std::ifstream(asset.name).good())
+			std::cerr << "Warning: " << asset.name << " is in the manifest but doesn't exist" << std::endl;
+	for (const auto& name : manifest.music)
+		if (!std::ifstream(name).good())
+			std::cerr << "Warning: " << name << " is in the manifest but doesn't exist" << std::endl;
+
+	std::cout << "Level " << levelnum << " manifest: " << manifest.textures.size() << " textures, "
+		<< manifest.sounds.size() << " sounds, " << manifest.music.size() << " music" << std::endl;
+
+	const auto sync = run(assets, manifest, frames, false);
+	const auto async = run(assets, manifest, frames, true);
+
+	std::cout << assets.size() << " assets over " << frames << " frames; ms spent loading per frame\n"
+		<< std::fixed << std::setprecision(3)
+		<< std::setw(6) << "" << std::setw(10) << "p50" << std::setw(10) << "p95"
+		<< std::setw(10) << "p99" << std::setw(10) << "max" << std::setw(10) << ">4ms" << "\n";
+	report("sync", sync);
+	report("async", async);
+
+	return 0;
+}
@@ -0,0 +1,169 @@
+/*!
+ * Microbenchmark: cost of AxisSighted::update against the number of entities.
+ *
+ * Compares the current implementation (walking the EntityGroup's tile index outwards from
+ * the owner) with the previous one (scanning all entities for each direction and sorting
+ * the ones on the same line), which is reproduced here as `LegacyAxisSighted`.
+ * Each measure is a full EntityGroup::updateAll(), so the current implementation also pays
+ * for rebuilding the tile index.
+ *
+ * Usage: bench_axis_sighted [iterations]
+ */
+#include "AxisSighted.hpp"
+#include "Collider.hpp"
+#include "EntityGroup.hpp"
+#include "Fixed.hpp"
+#include "utils.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+constexpr int LEVEL_WIDTH = 15,
+              LEVEL_HEIGHT = 13;
+
+/** The AxisSighted used before the tile index */
+class LegacyAxisSighted : public lif::Sighted {
+	using SeenPair = std::pair<lif::Entity*, unsigned>;
+
+	std::array<std::vector<SeenPair>, 4> seen;
+	std::array<float, 4> vision;
+
+	static bool _sameLine(lif::Direction dir, const sf::Vector2i& etile, const sf::Vector2i& mtile) {
+		switch (dir) {
+		case lif::Direction::UP:    return etile.x == mtile.x && etile.y < mtile.y;
+		case lif::Direction::LEFT:  return etile.y == mtile.y && etile.x < mtile.x;
+		case lif::Direction::DOWN:  return etile.x == mtile.x && etile.y > mtile.y;
+		case lif::Direction::RIGHT: return etile.y == mtile.y && etile.x > mtile.x;
+		default: return false;
+		}
+	}
+
+	void _fillLine(lif::Direction dir) {
+		const auto mtile = lif::tile2(owner.getPosition());
+		seen[dir].clear();
+
+		entities->apply([&] (const lif::Entity& e) {
+			if (&e == &owner)
+				return;
+			const auto etile = lif::tile2(e.getPosition());
+			if (!_sameLine(dir, etile, mtile)) return;
+			const auto dist = lif::manhattanDistance(etile, mtile);
+			if (visionRadius < 0 || dist <= visionRadius) {
+				const auto killable = e.get<lif::Killable>();
+				if (killable == nullptr || !killable->isKilled() || killable->isKillInProgress())
+					seen[dir].emplace_back(const_cast<lif::Entity*>(&e), dist);
+			}
+		});
+
+		std::sort(seen[dir].begin(), seen[dir].end(), [] (const SeenPair& a, const SeenPair& b) {
+			return a.second < b.second;
+		});
+
+		for (auto it = seen[dir].begin(); it != seen[dir].end(); ++it) {
+			const auto cld = it->first->get<lif::Collider>();
+			if (cld != nullptr && _isOpaque(cld->getLayer())) {
+				if (dir == lif::Direction::UP || dir == lif::Direction::DOWN)
+					vision[dir] = lif::abs(owner.getPosition().y - cld->getPosition().y);
+				else
+					vision[dir] = lif::abs(owner.getPosition().x - cld->getPosition().x);
+				seen[dir].erase(it, seen[dir].end());
+				break;
+			}
+		}
+	}
+
+public:
+	explicit LegacyAxisSighted(lif::Entity& owner)
+		: lif::Sighted(owner, -1)
+	{
+		_declComponent<LegacyAxisSighted>();
+	}
+
+	float getVision(lif::Direction dir) const { return vision[dir]; }
+
+	void update() override {
+		lif::Component::update();
+		vision.fill(-lif::TILE_SIZE);
+		for (unsigned i = 0; i < 4; ++i)
+			_fillLine(static_cast<lif::Direction>(i));
+	}
+};
+
+/** Fills `group` with `n` entities: about a third of them are walls, the rest are
+ *  sighted entities scattered across the level (not necessarily aligned to tiles).
+ */
+template<class S>
+void populate(lif::EntityGroup& group, int n, unsigned seed) {
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> tx(1, LEVEL_WIDTH), ty(1, LEVEL_HEIGHT), off(0, lif::TILE_SIZE - 1);
+	for (int i = 0; i < n; ++i) {
+		const sf::Vector2f tile(tx(rng) * lif::TILE_SIZE, ty(rng) * lif::TILE_SIZE);
+		auto e = new lif::Entity;
+		if (i % 3 == 0) {
+			e->setPosition(tile);
+			e->addComponent<lif::Fixed>(*e);
+			e->addComponent<lif::Collider>(*e, lif::c_layers::UNBREAKABLES);
+		} else {
+			const bool horizontal = rng() % 2 == 0;
+			e->setPosition(tile + (horizontal ? sf::Vector2f(off(rng), 0) : sf::Vector2f(0, off(rng))));
+			e->addComponent<lif::Collider>(*e, lif::c_layers::ENEMIES);
+			auto sighted = e->addComponent<S>(*e);
+			sighted->setEntityGroup(&group);
+			sighted->setOpaque({ lif::c_layers::BREAKABLES, lif::c_layers::UNBREAKABLES });
+		}
+		group.add(e);
+	}
+}
+
+/** @return The average time taken by `group.updateAll()`, in microseconds */
+double measure(lif::EntityGroup& group, long iterations) {
+	using Clock = std::chrono::steady_clock;
+	const auto start = Clock::now();
+	for (long i = 0; i < iterations; ++i)
+		group.updateAll();
+	return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / iterations;
+}
+
+/** @return The sum of the visions of all sighted entities of `group`, to cross-check the implementations */
+template<class S>
+double totalVision(const lif::EntityGroup& group) {
+	double tot = 0;
+	group.apply([&tot] (const lif::Entity& e) {
+		const auto sighted = e.get<S>();
+		if (sighted == nullptr) return;
+		for (unsigned i = 0; i < 4; ++i)
+			tot += sighted->getVision(static_cast<lif::Direction>(i));
+	});
+	return tot;
+}
+
+}
+
+int main(int argc, char **argv) {
+	const long iterations = argc > 1 ? std::max(1l, std::atol(argv[1])) : 50;
+
+	std::cout << "entities   scan+sort (us/update)   tile index (us/update)   speedup\n";
+	bool ok = true;
+	for (int n : { 50, 100, 200, 400, 800 }) {
+		lif::EntityGroup legacyGroup, currentGroup;
+		populate<LegacyAxisSighted>(legacyGroup, n, 42);
+		populate<lif::AxisSighted>(currentGroup, n, 42);
+
+		const double legacyUs = measure(legacyGroup, iterations);
+		const double currentUs = measure(currentGroup, iterations);
+		ok = ok && totalVision<LegacyAxisSighted>(legacyGroup) == totalVision<lif::AxisSighted>(currentGroup);
+
+		std::cout << std::fixed << std::setprecision(1)
+		          << std::setw(8) << n
+		          << std::setw(24) << legacyUs
+		          << std::setw(25) << currentUs
+		          << std::setw(9) << std::setprecision(2) << legacyUs / currentUs << "x\n";
+	}
+	if (!ok)
+		std::cerr << "WARNING: the two implementations disagree on what they see!" << std::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/*!
+ * Microbenchmark: cost of Entity::get<T>().
+ *
+ * Compares the current lookup (an index into the Entity's component slots) with the
+ * previous one (hashing a std::type_index into an unordered_map and copying the
+ * shared_ptr of the found component), which is reproduced here as `LegacyEntity`.
+ *
+ * Usage: bench_component_lookup [iterations]
+ */
+#include "Component.hpp"
+#include "Fixed.hpp"
+#include "Foe.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// A handful of tag components, so entities have a realistic number of keys
+template<int N>
+struct Tag : public lif::Component {
+	explicit Tag(lif::Entity& owner) : lif::Component(owner) {
+		_declComponent<Tag<N>>();
+	}
+};
+
+/** The component storage and lookup used by Entity before component ids */
+class LegacyEntity {
+	std::unordered_map<std::type_index, std::vector<std::shared_ptr<lif::Component>>> components;
+public:
+	template<class T>
+	void add(const std::shared_ptr<T>& comp) {
+		components[std::type_index(typeid(T))].emplace_back(comp);
+	}
+
+	template<class T>
+	std::shared_ptr<T> getShared() const {
+		auto comp = components.find(std::type_index(typeid(T)));
+		if (comp == components.end() || comp->second.size() == 0)
+			return std::shared_ptr<T>();
+		return std::static_pointer_cast<T>(comp->second[0]);
+	}
+
+	template<class T>
+	T* get() const { return getShared<T>().get(); }
+};
+
+constexpr int N_ENTITIES = 256;
+
+template<class E>
+double measure(const std::vector<E>& entities, long iterations) {
+	using Clock = std::chrono::steady_clock;
+	std::size_t found = 0;
+	const auto start = Clock::now();
+	for (long i = 0; i < iterations; ++i) {
+		for (const auto& e : entities) {
+			// Mix hits and misses, like game_logic and the collision detector do
+			found += e.template get<lif::Fixed>() != nullptr;
+			found += e.template get<lif::Foe>() != nullptr;
+			found += e.template get<Tag<3>>() != nullptr;
+			found += e.template get<Tag<7>>() != nullptr;
+		}
+	}
+	const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	if (found == 0)
+		std::cerr << "(nothing found)" << std::endl;
+	return elapsed / (iterations * entities.size() * 4.0);
+}
+
+template<class E, class F>
+std::vector<E> makeEntities(F addAll) {
+	std::vector<E> entities(N_ENTITIES);
+	for (int i = 0; i < N_ENTITIES; ++i)
+		addAll(entities[i], i);
+	return entities;
+}
+
+}
+
+int main(int argc, char **argv) {
+	const long iterations = argc > 1 ? std::max(1l, std::atol(argv[1])) : 2000;
+
+	// Owner of the legacy components (their owner is never used by the lookup)
+	lif::Entity dummy;
+	const auto legacy = makeEntities<LegacyEntity>([&dummy] (LegacyEntity& e, int i) {
+		e.add(std::make_shared<Tag<0>>(dummy));
+		e.add(std::make_shared<Tag<1>>(dummy));
+		e.add(std::make_shared<Tag<2>>(dummy));
+		e.add(std::make_shared<Tag<3>>(dummy));
+		if (i % 2 == 0)
+			e.add(std::make_shared<lif::Fixed>(dummy));
+		else
+			e.add(std::make_shared<lif::Foe>(dummy));
+	});
+	const auto current = makeEntities<lif::Entity>([] (lif::Entity& e, int i) {
+		e.addComponent<Tag<0>>(e);
+		e.addComponent<Tag<1>>(e);
+		e.addComponent<Tag<2>>(e);
+		e.addComponent<Tag<3>>(e);
+		if (i % 2 == 0)
+			e.addComponent<lif::Fixed>(e);
+		else
+			e.addComponent<lif::Foe>(e);
+	});
+
+	const double legacyNs = measure(legacy, iterations);
+	const double currentNs = measure(current, iterations);
+
+	std::cout << std::fixed << std::setprecision(2)
+	          << "type_index map + shared_ptr copy: " << legacyNs << " ns/lookup\n"
+	          << "component id slot:                " << currentNs << " ns/lookup\n"
+	          << "speedup:                          " << legacyNs / currentNs << "x" << std::endl;
+	return 0;
+}
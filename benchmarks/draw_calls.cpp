@@ -0,0 +1,120 @@
+/*!
+ * Benchmark: draw calls and drawing time per frame of LevelRenderer, with and without
+ * batching the sprites packed in the texture atlas and caching the walls into the static layer.
+ *
+ * Plays `ticks` simulation steps of a level (players standing still) and draws the level
+ * into an offscreen render texture after every step, once per rendering mode.
+ * With `downscale` > 1, the render texture has 1/downscale the level's resolution and the
+ * textures are mipmapped, as in a window that small (see lif::getRenderDownscale).
+ *
+ * Usage: bench_draw_calls [levelset.json] [level] [ticks] [downscale]
+ */
+#include "Controllable.hpp"
+#include "GameCache.hpp"
+#include "Level.hpp"
+#include "LevelManager.hpp"
+#include "LevelSet.hpp"
+#include "MusicManager.hpp"
+#include "Options.hpp"
+#include "Player.hpp"
+#include "Time.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Stats {
+	double drawCalls = 0;
+	double ms = 0;
+};
+
+Stats drawFrame(sf::RenderTarget& target, lif::LevelManager& lm, bool batching, bool staticCaching) {
+	using Clock = std::chrono::steady_clock;
+	lm.getRenderer().setBatching(batching);
+	lm.getRenderer().setStaticCaching(staticCaching);
+	const auto start = Clock::now();
+	target.draw(lm);
+	Stats stats;
+	stats.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	stats.drawCalls = lm.getRenderer().getDrawCalls();
+	return stats;
+}
+
+}
+
+int main(int argc, char **argv) {
+	const std::string levelsetName = argc > 1 ? argv[1] : "levels.json";
+	const int levelnum = argc > 2 ? std::atoi(argv[2]) : 1;
+	const int ticks = argc > 3 ? std::atoi(argv[3]) : 600;
+	const unsigned downscale = argc > 4 ? std::max(1, std::atoi(argv[4])) : 1;
+
+	lif::MusicManager mm;
+	lif::musicManager = &mm;
+	if (!lif::init()) {
+		std::cerr << "Failed to initialize the game!" << std::endl;
+		return 1;
+	}
+	lif::options.soundsMute = true;
+
+	// Also creates the GL context needed to load the textures
+	sf::RenderTexture target;
+	target.create(lif::GAME_WIDTH / downscale, lif::GAME_HEIGHT / downscale);
+	target.setView(sf::View(sf::FloatRect(0, 0, lif::GAME_WIDTH, lif::GAME_HEIGHT)));
+	lif::cache.setMipmapping(downscale > 1);
+
+	std::vector<std::string> atlasTextures;
+	for (auto name : lif::ATLAS_TEXTURES)
+		atlasTextures.emplace_back(lif::getAsset("graphics", name));
+	lif::cache.buildAtlas(atlasTextures);
+
+	lif::LevelSet ls;
+	if (!ls.loadFromFile(levelsetName) || levelnum < 1 || levelnum > ls.getLevelsNum()) {
+		std::cerr << "Failed to load level " << levelnum << " of " << levelsetName << std::endl;
+		return 1;
+	}
+	lif::LevelManager lm;
+	lm.getRenderer().setRenderDownscale(downscale);
+	lm.createNewPlayers(1);
+	lm.getPlayer(1)->get<lif::Controllable>()->setScript([] () { return lif::Controllable::Command(); });
+	lm.setLevel(ls, levelnum);
+	lm.resume();
+
+	const auto delta = sf::seconds(1 / 60.f);
+	Stats cached, batched, unbatched;
+	for (int i = 0; i < ticks; ++i) {
+		lif::time.step(delta);
+		lm.update();
+		target.clear();
+		const auto c = drawFrame(target, lm, true, true);
+		const auto b = drawFrame(target, lm, true, false);
+		const auto u = drawFrame(target, lm, false, false);
+		cached.drawCalls += c.drawCalls;
+		cached.ms += c.ms;
+		batched.drawCalls += b.drawCalls;
+		batched.ms += b.ms;
+		unbatched.drawCalls += u.drawCalls;
+		unbatched.ms += u.ms;
+	}
+
+	const auto size = target.getSize();
+	std::cout << "atlas pages: " << lif::cache.getAtlas().getPagesCount()
+		<< ", target: " << size.x << "x" << size.y
+		<< ", textures: " << lif::cache.getStats().gpuBytes / 1024 << " KiB\n"
+		<< std::fixed << std::setprecision(2)
+		<< std::setw(10) << "" << std::setw(14) << "draws/frame" << std::setw(12) << "ms/frame" << "\n"
+		<< std::setw(10) << "unbatched" << std::setw(14) << unbatched.drawCalls / ticks
+			<< std::setw(12) << unbatched.ms / ticks << "\n"
+		<< std::setw(10) << "batched" << std::setw(14) << batched.drawCalls / ticks
+			<< std::setw(12) << batched.ms / ticks << "\n"
+		<< std::setw(10) << "cached" << std::setw(14) << cached.drawCalls / ticks
+			<< std::setw(12) << cached.ms / ticks << std::endl;
+
+	lif::cache.finalize();
+	return 0;
+}
@@ -0,0 +1,87 @@
+/*!
+ * Benchmark: loading a levelset from its JSON versus from the compiled cache (see LevelSet).
+ *
+ * Measures (median of `runs` runs):
+ * - json: loading with no cache, i.e. parsing and compiling the JSON (and writing the cache);
+ * - cached: loading when the cache is up to date;
+ * - level: constructing the `level`-th level, which is the only one being decoded.
+ * The cache next to the JSON is left up to date.
+ *
+ * Usage: bench_levelset_loading [levelset.json] [level] [runs]
+ */
+#include "GameCache.hpp"
+#include "LevelSet.hpp"
+#include "MusicManager.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double median(std::vector<double> v) {
+	std::sort(v.begin(), v.end());
+	return v[v.size() / 2];
+}
+
+}
+
+int main(int argc, char **argv) {
+	const std::string levelsetName = argc > 1 ? argv[1] : "levels.json";
+	const int levelnum = argc > 2 ? std::atoi(argv[2]) : 1;
+	const int runs = argc > 3 ? std::max(1, std::atoi(argv[3])) : 20;
+
+	lif::MusicManager mm;
+	lif::musicManager = &mm;
+	if (!lif::init()) {
+		std::cerr << "Failed to initialize the game!" << std::endl;
+		return 1;
+	}
+
+	// Creates the GL context needed to upload the level's textures
+	sf::RenderTexture context;
+	context.create(1, 1);
+
+	const auto cachePath = lif::LevelSet::getCachePath(levelsetName);
+	std::vector<double> fromJSON, fromCache, level;
+	for (int r = 0; r < runs; ++r) {
+		std::remove(cachePath.c_str());
+		auto start = Clock::now();
+		{
+			lif::LevelSet ls;
+			if (!ls.loadFromFile(levelsetName) || levelnum < 1 || levelnum > ls.getLevelsNum()) {
+				std::cerr << "Failed to load level " << levelnum << " of " << levelsetName << std::endl;
+				return 1;
+			}
+		}
+		fromJSON.emplace_back(msSince(start));
+
+		start = Clock::now();
+		lif::LevelSet ls;
+		ls.loadFromFile(levelsetName);
+		fromCache.emplace_back(msSince(start));
+
+		start = Clock::now();
+		const auto lv = ls.getLevel(levelnum);
+		level.emplace_back(msSince(start));
+	}
+
+	std::cout << std::fixed << std::setprecision(3)
+		<< "median of " << runs << " runs, ms:\n"
+		<< std::setw(10) << "json" << std::setw(10) << "cached" << std::setw(10) << "level" << "\n"
+		<< std::setw(10) << median(fromJSON) << std::setw(10) << median(fromCache)
+		<< std::setw(10) << median(level) << "\n";
+
+	return 0;
+}
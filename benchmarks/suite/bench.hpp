@@ -0,0 +1,85 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * A minimal benchmark runner, so the suite measures and reports every benchmark the same way.
+ * Each benchmark is run in `samples` samples of the same number of iterations, which is
+ * calibrated so that a sample takes at least `minSampleTime`; the reported times are per iteration.
+ */
+namespace lif {
+class EntityGroup;
+}
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+/** Passed to the benchmark's body, which must run the measured operation `iterations` times */
+class State {
+	friend class Runner;
+
+	Clock::duration excluded = Clock::duration::zero();
+	Clock::time_point pauseStart;
+
+public:
+	long iterations = 1;
+
+	/** Excludes the time until the next `resume` from the measure (e.g. to set up the next batch) */
+	void pause() { pauseStart = Clock::now(); }
+	void resume() { excluded += Clock::now() - pauseStart; }
+};
+
+struct Result {
+	long iterations = 0;
+	int samples = 0;
+	double medianNs = 0,
+	       minNs = 0,
+	       maxNs = 0;
+	/** The median absolute deviation of the samples, relative to the median, in percent */
+	double madPct = 0;
+};
+
+class Runner {
+	std::string filter;
+	std::map<std::string, Result> results;
+
+public:
+	int samples = 10;
+	std::chrono::milliseconds minSampleTime { 5 };
+
+	explicit Runner(const std::string& filter = "") : filter(filter) {}
+
+	/** @return Whether the benchmark `name` is going to be run (i.e. it matches the filter) */
+	bool enabled(const std::string& name) const;
+
+	/** Measures `body` as benchmark `name`, unless it doesn't match the filter */
+	void run(const std::string& name, const std::function<void(State&)>& body);
+
+	const std::map<std::string, Result>& getResults() const { return results; }
+};
+
+/** Written to by the benchmarks, so the compiler can't optimize away what they compute */
+extern volatile std::uintptr_t sink;
+
+/** Fills `group` with `n` entities scattered across a 15x13 tiles level (the default level size):
+ *  about a third of them are walls, the rest are moving colliders. If `sighted`, the moving
+ *  ones also have an AxisSighted looking through `group`.
+ */
+void populate(lif::EntityGroup& group, int n, unsigned seed, bool sighted = false);
+
+/** The level limits of the levels filled by `populate` */
+sf::FloatRect levelLimit();
+
+// The benchmarks, by area
+void collisionBenchmarks(Runner& runner);
+void entityBenchmarks(Runner& runner);
+void levelBenchmarks(Runner& runner, const std::string& levelsetPath);
+
+}
@@ -0,0 +1,24 @@
+#include "bench.hpp"
+#include "EntityGroup.hpp"
+#include "SHCollisionDetector.hpp"
+#include "utils.hpp"
+
+void bench::collisionBenchmarks(Runner& runner) {
+	for (int n : { 50, 200, 800 }) {
+		for (unsigned subdivisions : { 1u, 4u, lif::DEFAULT_SHCD_SUBDIVISIONS, 14u }) {
+			const auto name = "cd_update/entities=" + lif::to_string(n)
+				+ "/subdivisions=" + lif::to_string(subdivisions);
+			if (!runner.enabled(name))
+				continue;
+
+			lif::EntityGroup group;
+			bench::populate(group, n, 42);
+			lif::SHCollisionDetector cd(group, bench::levelLimit(), subdivisions);
+			cd.rebuildStatic();
+			runner.run(name, [&cd] (State& state) {
+				for (long i = 0; i < state.iterations; ++i)
+					cd.update();
+			});
+		}
+	}
+}
@@ -0,0 +1,85 @@
+#include "bench.hpp"
+#include "AxisMoving.hpp"
+#include "Collider.hpp"
+#include "EntityGroup.hpp"
+#include "Fixed.hpp"
+#include "Killable.hpp"
+#include "utils.hpp"
+#include <vector>
+
+void bench::entityBenchmarks(Runner& runner) {
+	for (int n : { 100, 400, 1600 }) {
+		const auto name = "entity_group_update_all/entities=" + lif::to_string(n);
+		if (!runner.enabled(name))
+			continue;
+		lif::EntityGroup group;
+		bench::populate(group, n, 42);
+		runner.run(name, [&group] (State& state) {
+			for (long i = 0; i < state.iterations; ++i)
+				group.updateAll();
+		});
+	}
+
+	for (int n : { 50, 200, 800 }) {
+		const auto name = "axis_sighted_update/entities=" + lif::to_string(n);
+		if (!runner.enabled(name))
+			continue;
+		// As AxisSighted is updated along with its owner, this measures the whole group's update
+		lif::EntityGroup group;
+		bench::populate(group, n, 42, true);
+		runner.run(name, [&group] (State& state) {
+			for (long i = 0; i < state.iterations; ++i)
+				group.updateAll();
+		});
+	}
+
+	for (int n : { 1000, 4000 }) {
+		const auto name = "entity_group_kill/killed=" + lif::to_string(n);
+		if (!runner.enabled(name))
+			continue;
+		// Kills `n` entities in the same frame (like a big chain explosion), out of a group
+		// where as many survive, interleaved with them.
+		lif::EntityGroup group;
+		std::vector<lif::Killable*> victims;
+		victims.reserve(n);
+		runner.run(name, [&group, &victims, n] (State& state) {
+			for (long i = 0; i < state.iterations; ++i) {
+				state.pause();
+				group.clear();
+				victims.clear();
+				for (int j = 0; j < 2 * n; ++j) {
+					auto e = new lif::Entity(sf::Vector2f(j % 15, j / 15 % 13) * float(lif::TILE_SIZE));
+					e->addComponent<lif::Collider>(*e, lif::c_layers::ENEMIES);
+					auto klb = e->addComponent<lif::Killable>(*e);
+					if (j % 2 == 0)
+						victims.emplace_back(klb);
+					group.add(e);
+				}
+				for (auto klb : victims)
+					klb->kill();
+				state.resume();
+
+				group.checkAll();
+			}
+			bench::sink = group.size();
+		});
+	}
+
+	// A moving entity with the usual amount of components
+	lif::Entity entity;
+	entity.addComponent<lif::Collider>(entity, lif::c_layers::ENEMIES);
+	entity.addComponent<lif::AxisMoving>(entity, 100.f);
+	entity.addComponent<lif::Killable>(entity);
+	runner.run("entity_get/hit", [&entity] (State& state) {
+		std::uintptr_t acc = 0;
+		for (long i = 0; i < state.iterations; ++i)
+			acc += reinterpret_cast<std::uintptr_t>(entity.get<lif::AxisMoving>());
+		bench::sink = acc;
+	});
+	runner.run("entity_get/miss", [&entity] (State& state) {
+		std::uintptr_t acc = 0;
+		for (long i = 0; i < state.iterations; ++i)
+			acc += reinterpret_cast<std::uintptr_t>(entity.get<lif::Fixed>());
+		bench::sink = acc;
+	});
+}
@@ -0,0 +1,50 @@
+#include "bench.hpp"
+#include "AxisMoving.hpp"
+#include "AxisSighted.hpp"
+#include "Collider.hpp"
+#include "EntityGroup.hpp"
+#include "Fixed.hpp"
+#include "Killable.hpp"
+#include "core.hpp"
+#include <random>
+
+namespace {
+
+constexpr int LEVEL_WIDTH = 15,
+              LEVEL_HEIGHT = 13;
+
+}
+
+sf::FloatRect bench::levelLimit() {
+	return sf::FloatRect(lif::TILE_SIZE, lif::TILE_SIZE,
+			(LEVEL_WIDTH + 1) * lif::TILE_SIZE, (LEVEL_HEIGHT + 1) * lif::TILE_SIZE);
+}
+
+void bench::populate(lif::EntityGroup& group, int n, unsigned seed, bool sighted) {
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> tx(1, LEVEL_WIDTH), ty(1, LEVEL_HEIGHT),
+	                                   off(0, lif::TILE_SIZE - 1), dir(0, 3);
+	for (int i = 0; i < n; ++i) {
+		const sf::Vector2f tile(tx(rng) * lif::TILE_SIZE, ty(rng) * lif::TILE_SIZE);
+		auto e = new lif::Entity;
+		if (i % 3 == 0) {
+			e->setPosition(tile);
+			e->addComponent<lif::Fixed>(*e);
+			e->addComponent<lif::Collider>(*e, lif::c_layers::UNBREAKABLES);
+		} else {
+			const auto d = static_cast<lif::Direction>(dir(rng));
+			const bool horizontal = d == lif::Direction::LEFT || d == lif::Direction::RIGHT;
+			e->setPosition(tile + (horizontal ? sf::Vector2f(off(rng), 0) : sf::Vector2f(0, off(rng))));
+			e->addComponent<lif::Collider>(*e, lif::c_layers::ENEMIES);
+			e->addComponent<lif::AxisMoving>(*e, 100.f, d);
+			e->addComponent<lif::Killable>(*e);
+			if (sighted) {
+				auto s = e->addComponent<lif::AxisSighted>(*e);
+				s->setEntityGroup(&group);
+				s->setOpaque({ lif::c_layers::BREAKABLES, lif::c_layers::UNBREAKABLES });
+			}
+		}
+		group.add(e);
+	}
+	group.validate();
+}
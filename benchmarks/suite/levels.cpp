@@ -0,0 +1,90 @@
+#include "bench.hpp"
+#include "EntityGroup.hpp"
+#include "Explosion.hpp"
+#include "LevelLoader.hpp"
+#include "LevelManager.hpp"
+#include "LevelSet.hpp"
+#include "collision_utils.hpp"
+#include "game.hpp"
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+/** @return `num` zero-padded to the digits of `max`, so that the benchmarks sort by level */
+static std::string padded(unsigned num, unsigned max) {
+	std::stringstream ss;
+	ss << std::setw(lif::to_string(max).length()) << std::setfill('0') << num;
+	return ss.str();
+}
+
+void bench::levelBenchmarks(Runner& runner, const std::string& levelsetPath) {
+	lif::LevelSet ls;
+	if (!ls.loadFromFile(levelsetPath)) {
+		std::cerr << "Failed to load " << levelsetPath << ": skipping the level benchmarks" << std::endl;
+		return;
+	}
+	const unsigned nLevels = ls.getLevelsNum();
+	lif::rng.seed(0);
+
+	lif::LevelManager lm;
+	lm.createNewPlayers(1);
+
+	for (unsigned lvnum = 1; lvnum <= nLevels; ++lvnum) {
+		const auto name = "level_load/level=" + padded(lvnum, nLevels);
+		if (!runner.enabled(name))
+			continue;
+		// The level's enemies are looked up in the LevelManager's level
+		lm.setLevel(ls, lvnum);
+		runner.run(name, [&lm] (State& state) {
+			for (long i = 0; i < state.iterations; ++i)
+				lif::LevelLoader::load(*lm.getLevel(), lm);
+		});
+	}
+
+	for (unsigned lvnum : { 1u, (nLevels + 1) / 2, nLevels }) {
+		const auto name = "find_free_tiles/level=" + padded(lvnum, nLevels);
+		if (!runner.enabled(name))
+			continue;
+		lm.setLevel(ls, lvnum);
+		lm.getEntities().validate();
+		runner.run(name, [&lm] (State& state) {
+			std::uintptr_t acc = 0;
+			for (long i = 0; i < state.iterations; ++i)
+				acc += lif::collision_utils::findFreeTiles(lm).size();
+			bench::sink = acc;
+		});
+	}
+
+	for (unsigned short radius : { 2, 8 }) {
+		const auto name = "explosion_propagate/radius=" + lif::to_string(radius);
+		if (!runner.enabled(name))
+			continue;
+		lm.setLevel(ls, 1);
+		lm.getEntities().validate();
+		const auto& info = lm.getLevel()->getInfo();
+		runner.run(name, [&lm, &info, radius] (State& state) {
+			// Explosions are created and destroyed in batches, outside of the measure
+			constexpr long BATCH = 64;
+			std::vector<std::unique_ptr<lif::Explosion>> batch;
+			batch.reserve(BATCH);
+			for (long done = 0; done < state.iterations; done += batch.size()) {
+				state.pause();
+				batch.clear();
+				for (long i = done; i < std::min(state.iterations, done + BATCH); ++i) {
+					// Cycle through all the tiles of the level
+					const auto t = i % (info.width * info.height);
+					const sf::Vector2f pos((t % info.width + 1) * lif::TILE_SIZE, (t / info.width + 1) * lif::TILE_SIZE);
+					batch.emplace_back(new lif::Explosion(pos, radius));
+				}
+				state.resume();
+				for (auto& expl : batch)
+					expl->propagate(lm);
+			}
+			state.pause();
+			batch.clear();
+			state.resume();
+		});
+	}
+}
@@ -0,0 +1,187 @@
+/*!
+ * Benchmark suite covering the engine's hot paths.
+ *
+ * Runs all the benchmarks (or the ones whose name contains `filter`) and outputs their results
+ * as JSON, with the benchmarks sorted by name and all the inputs generated from fixed seeds,
+ * so that the outputs of two commits can be compared, also via `-c`.
+ *
+ * Usage: bench_suite [-f filter] [-s samples] [-m min sample ms] [-o out.json] [-c baseline.json] [levelset.json]
+ */
+#include "bench.hpp"
+#include "GameCache.hpp"
+#include "MusicManager.hpp"
+#include "Options.hpp"
+#include "game.hpp"
+#include "json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using json = nlohmann::json;
+
+volatile std::uintptr_t bench::sink = 0;
+
+bool bench::Runner::enabled(const std::string& name) const {
+	return name.find(filter) != std::string::npos;
+}
+
+void bench::Runner::run(const std::string& name, const std::function<void(State&)>& body) {
+	if (!enabled(name))
+		return;
+
+	const auto sample = [&body] (long iterations) {
+		State state;
+		state.iterations = iterations;
+		const auto start = Clock::now();
+		body(state);
+		return Clock::now() - start - state.excluded;
+	};
+
+	// Calibrate the iterations per sample (this also warms up the caches)
+	long iterations = 1;
+	for (auto t = sample(iterations); t < minSampleTime && iterations < (1l << 30); t = sample(iterations)) {
+		const double ratio = std::chrono::duration<double>(minSampleTime).count()
+			/ std::max(std::chrono::duration<double>(t).count(), 1e-9);
+		iterations = static_cast<long>(std::ceil(iterations * std::min(std::max(ratio * 1.2, 2.0), 100.0)));
+	}
+
+	std::vector<double> times;
+	for (int i = 0; i < samples; ++i)
+		times.emplace_back(std::chrono::duration<double, std::nano>(sample(iterations)).count() / iterations);
+	std::sort(times.begin(), times.end());
+	const auto median = [] (const std::vector<double>& v) {
+		return v.size() % 2 ? v[v.size() / 2] : (v[v.size() / 2 - 1] + v[v.size() / 2]) / 2;
+	};
+
+	Result res;
+	res.iterations = iterations;
+	res.samples = samples;
+	res.medianNs = median(times);
+	res.minNs = times.front();
+	res.maxNs = times.back();
+	std::vector<double> deviations;
+	for (auto t : times)
+		deviations.emplace_back(std::abs(t - res.medianNs));
+	std::sort(deviations.begin(), deviations.end());
+	res.madPct = res.medianNs > 0 ? median(deviations) / res.medianNs * 100 : 0;
+	results[name] = res;
+
+	std::cerr << std::fixed << std::setprecision(1) << std::left << std::setw(48) << name
+		<< std::right << std::setw(14) << res.medianNs << " ns  +-" << res.madPct << "%" << std::endl;
+}
+
+/** Prints how each benchmark in both `baseline` and `current` changed */
+static void compare(const json& baseline, const json& current) {
+	const auto& base = baseline["benchmarks"];
+	std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(14) << "base (ns)"
+		<< std::setw(14) << "new (ns)" << std::setw(10) << "change" << "\n";
+	for (auto it = current["benchmarks"].begin(); it != current["benchmarks"].end(); ++it) {
+		const auto b = base.find(it.key());
+		if (b == base.end())
+			continue;
+		const double oldNs = (*b)["median_ns"], newNs = (*it)["median_ns"];
+		const double change = oldNs > 0 ? (newNs / oldNs - 1) * 100 : 0;
+		// Changes within the noise of either run are not significant
+		const double noise = 2 * std::max((*b)["mad_pct"].get<double>(), (*it)["mad_pct"].get<double>());
+		std::cout << std::fixed << std::setprecision(1) << std::left << std::setw(48) << it.key()
+			<< std::right << std::setw(14) << oldNs << std::setw(14) << newNs
+			<< std::setw(9) << std::showpos << change << std::noshowpos << "%"
+			<< (std::abs(change) > noise ? (change < 0 ? "  faster" : "  SLOWER") : "") << "\n";
+	}
+}
+
+int main(int argc, char **argv) {
+	std::string filter, outFile, baselineFile, levelsetPath;
+	int samples = 10;
+	long minSampleMs = 5;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg(argv[i]);
+		if (arg == "-f" && i < argc - 1) {
+			filter = argv[++i];
+		} else if (arg == "-s" && i < argc - 1) {
+			samples = std::max(1, std::atoi(argv[++i]));
+		} else if (arg == "-m" && i < argc - 1) {
+			minSampleMs = std::max(1l, std::atol(argv[++i]));
+		} else if (arg == "-o" && i < argc - 1) {
+			outFile = argv[++i];
+		} else if (arg == "-c" && i < argc - 1) {
+			baselineFile = argv[++i];
+		} else if (arg[0] == '-') {
+			std::cout << "Usage: " << argv[0] << " [-f filter] [-s samples] [-m min sample ms]"
+			             " [-o out.json] [-c baseline.json] [levelset.json]\r\n"
+			          << "\t-f: only run the benchmarks whose name contains <filter>\r\n"
+			          << "\t-s: samples per benchmark (default: 10)\r\n"
+			          << "\t-m: minimum duration of a sample (default: 5 ms)\r\n"
+			          << "\t-o: write the JSON results to <out.json> rather than stdout\r\n"
+			          << "\t-c: compare the results with the ones in <baseline.json>\r\n"
+			          << "\tlevelset.json: the levels to benchmark (default: levels.json)" << std::endl;
+			return 1;
+		} else {
+			levelsetPath = arg;
+		}
+	}
+
+	lif::MusicManager mm;
+	lif::musicManager = &mm;
+	if (!lif::init()) {
+		std::cerr << "Failed to initialize the game!" << std::endl;
+		return 1;
+	}
+	// Only measure the game logic, like lifish_headless
+	lif::cache.setHeadless(true);
+	lif::options.soundsMute = true;
+	if (levelsetPath.length() == 0)
+		levelsetPath = std::string(lif::pwd) + lif::DIRSEP + "levels.json";
+
+	bench::Runner runner(filter);
+	runner.samples = samples;
+	runner.minSampleTime = std::chrono::milliseconds(minSampleMs);
+	bench::collisionBenchmarks(runner);
+	bench::entityBenchmarks(runner);
+	bench::levelBenchmarks(runner, levelsetPath);
+
+	json result;
+	result["commit"] = COMMIT;
+	result["version"] = VERSION;
+#ifdef RELEASE
+	result["build"] = "release";
+#else
+	result["build"] = "debug";
+#endif
+	result["samples"] = samples;
+	result["min_sample_ms"] = minSampleMs;
+	json benchmarks = json::object();
+	for (const auto& pair : runner.getResults()) {
+		const auto& res = pair.second;
+		benchmarks[pair.first] = {
+			{ "iterations", res.iterations },
+			{ "samples", res.samples },
+			{ "median_ns", res.medianNs },
+			{ "min_ns", res.minNs },
+			{ "max_ns", res.maxNs },
+			{ "mad_pct", res.madPct }
+		};
+	}
+	result["benchmarks"] = benchmarks;
+
+	if (outFile.length() > 0) {
+		std::ofstream out(outFile);
+		out << result.dump(4) << std::endl;
+	} else if (baselineFile.length() == 0) {
+		std::cout << result.dump(4) << std::endl;
+	}
+
+	if (baselineFile.length() > 0) {
+		std::ifstream in(baselineFile);
+		if (!in) {
+			std::cerr << "Failed to read " << baselineFile << std::endl;
+			return 1;
+		}
+		compare(json::parse(in), result);
+	}
+
+	return 0;
+}
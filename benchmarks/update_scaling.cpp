@@ -0,0 +1,132 @@
+/*!
+ * Benchmark: scaling of LevelManager::update with the number of threads updating the entities
+ * (see JobSystem and EntityGroup::updateAll).
+ *
+ * For each thread count (1, 2, 4, ... up to the hardware threads) it loads `level`, adds
+ * `enemies` more enemies on its free tiles, then times `ticks` updates at 60 ticks/s with
+ * an idle player. Prints the median and mean time per tick, the speedup over 1 thread and
+ * the hash of the final state, which must be the same for all thread counts.
+ *
+ * Usage: bench_update_scaling [levelset.json] [level] [enemies] [ticks]
+ */
+#include "Controllable.hpp"
+#include "EnemyFactory.hpp"
+#include "GameCache.hpp"
+#include "InputRecording.hpp"
+#include "JobSystem.hpp"
+#include "LevelManager.hpp"
+#include "LevelSet.hpp"
+#include "MusicManager.hpp"
+#include "Options.hpp"
+#include "Player.hpp"
+#include "Time.hpp"
+#include "collision_utils.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+	unsigned threads;
+	double median;
+	double mean;
+	std::size_t entities;
+	std::uint32_t stateHash;
+};
+
+Result run(const lif::LevelSet& ls, int levelnum, int nEnemies, unsigned ticks, unsigned threads) {
+	lif::options.updateThreads = threads;
+	lif::rng.seed(0);
+
+	lif::LevelManager lm;
+	lm.createNewPlayers(1);
+	lm.getPlayer(1)->get<lif::Controllable>()->setScript([] () { return lif::Controllable::Command(); });
+	lm.setLevel(ls, levelnum);
+
+	// Spread the extra enemies over the free tiles, cycling through all enemy types
+	const auto tiles = lif::collision_utils::findFreeTiles(lm);
+	for (int i = 0; i < nEnemies && !tiles.empty(); ++i) {
+		const auto& tile = tiles[i % tiles.size()];
+		lm.getEntities().add(lif::EnemyFactory::create(lm, i % lif::N_ENEMIES + 1,
+				sf::Vector2f(tile) * float(lif::TILE_SIZE)).release());
+	}
+	lm.resume();
+
+	const auto delta = sf::microseconds(1'000'000 / 60);
+	std::vector<double> times;
+	times.reserve(ticks);
+	for (unsigned t = 0; t < ticks; ++t) {
+		lif::time.step(delta);
+		const auto start = Clock::now();
+		lm.update();
+		times.emplace_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	}
+
+	Result res;
+	res.threads = lm.getJobSystem().getThreadsCount();
+	res.mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+	std::sort(times.begin(), times.end());
+	res.median = times[times.size() / 2];
+	res.entities = lm.getEntities().size();
+	res.stateHash = lif::InputRecording::hashState(lm.getEntities());
+	return res;
+}
+
+}
+
+int main(int argc, char **argv) {
+	const std::string levelsetName = argc > 1 ? argv[1] : "levels.json";
+	const int levelnum = argc > 2 ? std::atoi(argv[2]) : 1;
+	const int nEnemies = argc > 3 ? std::max(0, std::atoi(argv[3])) : 500;
+	const unsigned ticks = argc > 4 ? std::max(1, std::atoi(argv[4])) : 600;
+
+	lif::MusicManager mm;
+	lif::musicManager = &mm;
+	if (!lif::init()) {
+		std::cerr << "Failed to initialize the game!" << std::endl;
+		return 1;
+	}
+	lif::cache.setHeadless(true);
+	lif::options.soundsMute = true;
+
+	lif::LevelSet ls;
+	if (!ls.loadFromFile(levelsetName) || levelnum < 1 || levelnum > ls.getLevelsNum()) {
+		std::cerr << "Failed to load level " << levelnum << " of " << levelsetName << std::endl;
+		return 1;
+	}
+
+	const unsigned maxThreads = std::max(4u, std::thread::hardware_concurrency());
+	std::vector<Result> results;
+	for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+		results.emplace_back(run(ls, levelnum, nEnemies, ticks, threads));
+
+	std::cout << "Level " << levelnum << ", " << results[0].entities << " entities, " << ticks
+	          << " ticks (" << std::thread::hardware_concurrency() << " hardware threads)\n"
+	          << std::fixed << std::setprecision(3)
+	          << std::setw(8) << "threads" << std::setw(14) << "median ms" << std::setw(12) << "mean ms"
+	          << std::setw(10) << "speedup" << "  state hash\n";
+	bool deterministic = true;
+	for (const auto& r : results) {
+		deterministic &= r.stateHash == results[0].stateHash;
+		std::cout << std::setw(8) << r.threads << std::setw(14) << r.median << std::setw(12) << r.mean
+		          << std::setw(9) << std::setprecision(2) << results[0].median / r.median << "x"
+		          << std::setprecision(3) << "  " << std::hex << r.stateHash << std::dec << "\n";
+	}
+	if (!deterministic) {
+		std::cerr << "The final state depends on the number of threads!" << std::endl;
+		return 1;
+	}
+
+	lif::cache.finalize();
+	return 0;
+}
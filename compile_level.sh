@@ -1,3 +1,9 @@
-cd src
-clang++ -O0 -ggdb -std=c++11 Killable.cpp Animation.cpp Bomb.cpp AnimatedSprite.cpp Animated.cpp EntityType.cpp GameCache.cpp Level.cpp test_level.cpp LevelSet.cpp LevelNumText.cpp Music.cpp Game.cpp Texture.cpp ShadedText.cpp Track.cpp utils.cpp Entity.cpp EntityGroup.cpp Coin.cpp -lsfml-window -lsfml-graphics -lsfml-system -lsfml-audio -o ../test_level
-cd ..
+#!/bin/sh
+# Compiles the given levelset JSONs (default: levels.json) into the binary levelsets
+# the game loads (see LevelSet), building the compiler first if needed.
+set -e
+BUILD_DIR=${BUILD_DIR:-build}
+cmake -S . -B "$BUILD_DIR" >/dev/null
+cmake --build "$BUILD_DIR" --target lifish_compile_levels
+[ $# -gt 0 ] || set -- levels.json
+"$BUILD_DIR/lifish_compile_levels" "$@"
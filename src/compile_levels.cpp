@@ -0,0 +1,56 @@
+/*!
+ * Lifish levelset compiler
+ * @copyright 2017, Giacomo Parolini
+ *
+ * Compiles levelset JSONs into the binary form the game loads them from (see LevelSet).
+ * The game does this by itself when the cache next to a JSON is missing or stale, so this
+ * is only needed to ship the compiled levelsets along with the JSONs.
+ *
+ * This game is licensed under the Lifish License, available at
+ * https://silverweed.github.io/lifish-license.txt
+ * or in the LICENSE file in this repository's root directory.
+*/
+#include "LevelSet.hpp"
+#include "core.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+	if (!lif::initCore()) {
+		std::cerr << "Failed to initialize!" << std::endl;
+		return 1;
+	}
+
+	std::string outPath;
+	std::vector<std::string> jsonPaths;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg(argv[i]);
+		if (arg == "-o" && i < argc - 1) {
+			outPath = argv[++i];
+		} else if (arg[0] == '-') {
+			jsonPaths.clear();
+			break;
+		} else {
+			jsonPaths.emplace_back(arg);
+		}
+	}
+	if (jsonPaths.empty() || (outPath.length() > 0 && jsonPaths.size() > 1)) {
+		std::cout << "Usage: " << argv[0] << " [-o <out>] <levelset.json...>\r\n"
+		          << "\t-o: the file to write (default: <levelset.json>.bin; only valid with a single levelset)"
+		          << std::endl;
+		return 1;
+	}
+
+	int failed = 0;
+	for (const auto& jsonPath : jsonPaths) {
+		const auto out = outPath.length() > 0 ? outPath : lif::LevelSet::getCachePath(jsonPath);
+		if (!lif::LevelSet::compile(jsonPath, out)) {
+			++failed;
+			continue;
+		}
+		std::cout << "Compiled " << jsonPath << " into " << out << std::endl;
+	}
+
+	return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+#include "AssetArchive.hpp"
+#include "core.hpp"
+#include "dirent.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+#ifdef _WIN32
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+using lif::AssetArchive;
+
+constexpr char AssetArchive::MAGIC[8];
+constexpr std::uint32_t AssetArchive::FORMAT_VERSION;
+
+/** @return `relPath` with '/' as separator, which is how entries are named */
+static std::string entryName(std::string relPath) {
+	std::replace(relPath.begin(), relPath.end(), lif::DIRSEP, '/');
+	return relPath;
+}
+
+AssetArchive::~AssetArchive() {
+	close();
+}
+
+bool AssetArchive::open(const std::string& path, const std::string& rootDir) {
+	close();
+
+#ifdef _WIN32
+	const auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	fileHandle = file;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		_unmap();
+		return false;
+	}
+	mappedSize = static_cast<std::size_t>(size.QuadPart);
+	mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr) {
+		_unmap();
+		return false;
+	}
+	mapped = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+	mappedSize = static_cast<std::size_t>(st.st_size);
+	void *addr = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps the file alive on its own
+	::close(fd);
+	mapped = addr != MAP_FAILED ? static_cast<const char*>(addr) : nullptr;
+#endif
+	if (mapped == nullptr) {
+		_unmap();
+		return false;
+	}
+
+	// Validate the header and the index
+	Header header;
+	if (mappedSize < sizeof(Header)) {
+		close();
+		return false;
+	}
+	std::memcpy(&header, mapped, sizeof(Header));
+	const auto indexEnd = sizeof(Header) + std::size_t(header.nEntries) * sizeof(Entry);
+	if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION
+			|| indexEnd > mappedSize)
+	{
+		std::cerr << "[AssetArchive] Error: " << path << " is not a valid asset archive" << std::endl;
+		close();
+		return false;
+	}
+	entries = reinterpret_cast<const Entry*>(mapped + sizeof(Header));
+	nEntries = header.nEntries;
+	names = mapped + indexEnd;
+	// The names end where the first file's content begins
+	std::size_t namesEnd = mappedSize;
+	for (unsigned i = 0; i < nEntries; ++i)
+		namesEnd = std::min(namesEnd, std::size_t(entries[i].offset));
+	for (unsigned i = 0; i < nEntries; ++i) {
+		const auto& e = entries[i];
+		// Each name must be NUL-terminated within the names, as `find` reads it as a C string
+		if (std::size_t(e.offset) + e.size > mappedSize || namesEnd < indexEnd
+				|| e.nameOffset >= namesEnd - indexEnd
+				|| std::memchr(names + e.nameOffset, '\0', namesEnd - indexEnd - e.nameOffset) == nullptr)
+		{
+			std::cerr << "[AssetArchive] Error: " << path << " is truncated" << std::endl;
+			close();
+			return false;
+		}
+	}
+	root = rootDir;
+
+	return true;
+}
+
+void AssetArchive::_unmap() {
+#ifdef _WIN32
+	if (mapped != nullptr)
+		UnmapViewOfFile(mapped);
+	if (mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	if (fileHandle != nullptr)
+		CloseHandle(fileHandle);
+	mappingHandle = fileHandle = nullptr;
+#else
+	if (mapped != nullptr)
+		munmap(const_cast<char*>(mapped), mappedSize);
+#endif
+	mapped = nullptr;
+	mappedSize = 0;
+}
+
+void AssetArchive::close() {
+	_unmap();
+	entries = nullptr;
+	nEntries = 0;
+	names = nullptr;
+	root.clear();
+}
+
+AssetArchive::Data AssetArchive::find(const std::string& path) const {
+	Data data;
+	if (mapped == nullptr || path.compare(0, root.length(), root) != 0)
+		return data;
+
+	const auto name = entryName(path.substr(root.length()));
+	const auto id = lif::hashing::fnv1_hash(name.c_str());
+	const auto end = entries + nEntries;
+	const auto it = std::lower_bound(entries, end, id, [] (const Entry& e, lif::StringId id) {
+		return e.id < id;
+	});
+	// Also check the name, as a file which is not packed may have the id of one which is
+	if (it == end || it->id != id || name != names + it->nameOffset)
+		return data;
+
+	data.data = mapped + it->offset;
+	data.size = it->size;
+	return data;
+}
+
+/** Appends the paths (relative to `rootDir`) of all the files under `rootDir`/`relDir` */
+static void listFiles(const std::string& rootDir, const std::string& relDir, std::vector<std::string>& out) {
+	auto dir = opendir((rootDir + relDir).c_str());
+	if (dir == NULL)
+		return;
+
+	for (auto ent = readdir(dir); ent != NULL; ent = readdir(dir)) {
+		if (ent->d_name[0] == '.')
+			continue;
+		const auto relPath = relDir + lif::DIRSEP + ent->d_name;
+		auto sub = opendir((rootDir + relPath).c_str());
+		if (sub != NULL) {
+			closedir(sub);
+			listFiles(rootDir, relPath, out);
+		} else {
+			out.emplace_back(relPath);
+		}
+	}
+	closedir(dir);
+}
+
+bool AssetArchive::pack(const std::string& rootDir, const std::vector<std::string>& subdirs,
+		const std::string& outPath)
+{
+	std::vector<std::string> files;
+	for (const auto& subdir : subdirs)
+		listFiles(rootDir, subdir, files);
+
+	struct Packed {
+		Entry entry;
+		std::string name;
+		std::vector<char> content;
+	};
+	std::vector<Packed> packed;
+	packed.reserve(files.size());
+	std::size_t namesSize = 0;
+	for (const auto& relPath : files) {
+		std::ifstream file(rootDir + relPath, std::ios::binary);
+		if (!file) {
+			std::cerr << "[AssetArchive] Error: couldn't read " << relPath << std::endl;
+			return false;
+		}
+		Packed p;
+		p.name = entryName(relPath);
+		p.content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		p.entry.id = lif::hashing::fnv1_hash(p.name.c_str());
+		p.entry.size = p.content.size();
+		namesSize += p.name.length() + 1;
+		packed.emplace_back(std::move(p));
+	}
+	std::sort(packed.begin(), packed.end(), [] (const Packed& a, const Packed& b) {
+		return a.entry.id < b.entry.id;
+	});
+	for (unsigned i = 1; i < packed.size(); ++i) {
+		if (packed[i].entry.id == packed[i - 1].entry.id) {
+			std::cerr << "[AssetArchive] Error: " << packed[i - 1].name << " and " << packed[i].name
+				<< " have the same StringId" << std::endl;
+			return false;
+		}
+	}
+
+	std::size_t nameOffset = 0;
+	std::size_t offset = sizeof(Header) + packed.size() * sizeof(Entry) + namesSize;
+	for (auto& p : packed) {
+		p.entry.nameOffset = nameOffset;
+		nameOffset += p.name.length() + 1;
+		if (offset + p.content.size() > std::numeric_limits<std::uint32_t>::max()) {
+			std::cerr << "[AssetArchive] Error: the archive would exceed 4 GiB" << std::endl;
+			return false;
+		}
+		p.entry.offset = offset;
+		offset += p.content.size();
+	}
+
+	std::ofstream out(outPath, std::ios::binary);
+	Header header;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = FORMAT_VERSION;
+	header.nEntries = packed.size();
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	for (const auto& p : packed)
+		out.write(reinterpret_cast<const char*>(&p.entry), sizeof(Entry));
+	for (const auto& p : packed)
+		out.write(p.name.c_str(), p.name.length() + 1);
+	for (const auto& p : packed)
+		out.write(p.content.data(), p.content.size());
+
+	if (!out) {
+		std::cerr << "[AssetArchive] Error: couldn't write " << outPath << std::endl;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "sid.hpp"
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lif {
+
+/**
+ * A read-only archive packing many asset files into a single file, which is memory-mapped
+ * so that assets can be loaded from memory with a single open for all of them.
+ *
+ * Layout (all integers in host byte order, as the archive is built on the target machine):
+ *   Header  { char magic[8]; uint32 version; uint32 nEntries; }
+ *   Entry   { uint32 id; uint32 nameOffset; uint32 offset; uint32 size; } x nEntries, sorted by id
+ *   the entries' names, NUL-terminated (nameOffset is relative to the first name)
+ *   the files' contents (offset is relative to the start of the archive)
+ * Each entry's `id` is the lif::sid hash of its path relative to the packed directory, with
+ * '/' as separator (e.g. "graphics/bomb.png").
+ */
+class AssetArchive final : private sf::NonCopyable {
+public:
+	/** A packed file's content, valid as long as the archive is open */
+	struct Data {
+		const void *data = nullptr;
+		std::size_t size = 0;
+
+		explicit operator bool() const { return data != nullptr; }
+	};
+
+private:
+	struct Header {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t nEntries;
+	};
+	struct Entry {
+		lif::StringId id;
+		std::uint32_t nameOffset;
+		std::uint32_t offset;
+		std::uint32_t size;
+	};
+
+	static constexpr char MAGIC[8] = { 'L', 'I', 'F', 'P', 'A', 'K', '\0', '\0' };
+	static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+	/** Paths given to `find` are relative to this directory */
+	std::string root;
+
+	const char *mapped = nullptr;
+	std::size_t mappedSize = 0;
+#ifdef _WIN32
+	void *fileHandle = nullptr;
+	void *mappingHandle = nullptr;
+#endif
+	const Entry *entries = nullptr;
+	std::uint32_t nEntries = 0;
+	const char *names = nullptr;
+
+	void _unmap();
+
+public:
+	~AssetArchive();
+
+	/** Maps the archive `path`, whose entries are relative to `rootDir` (with a trailing
+	 *  separator). Closes the currently open archive, if any.
+	 *  @return Whether the archive was valid and could be mapped
+	 */
+	bool open(const std::string& path, const std::string& rootDir);
+	void close();
+	bool isOpen() const { return mapped != nullptr; }
+
+	/** @return The content of the file `path` (which must be under the root directory),
+	 *  or an empty Data if it's not in this archive.
+	 */
+	Data find(const std::string& path) const;
+
+	std::size_t getEntriesCount() const { return nEntries; }
+
+	/** Packs all the files under `rootDir`/`subdir` for each of `subdirs` into the archive
+	 *  `outPath`. Errors are reported to stderr.
+	 *  @return Whether the archive was written
+	 */
+	static bool pack(const std::string& rootDir, const std::vector<std::string>& subdirs,
+			const std::string& outPath);
+};
+
+}
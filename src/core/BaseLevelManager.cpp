@@ -1,13 +1,19 @@
 #include "BaseLevelManager.hpp"
 #include "AxisMoving.hpp"
 #include "Clock.hpp"
+#include "Options.hpp"
 #include "Time.hpp"
+#include "core.hpp"
 
 using lif::BaseLevelManager;
 
 BaseLevelManager::BaseLevelManager()
-	: cd(entities)
-{}
+	: jobs(lif::options.updateThreads)
+	, cd(entities)
+	, occupancy(entities)
+{
+	entities.setJobSystem(&jobs);
+}
 
 void BaseLevelManager::update() {
 	DBGSTART("tot");
@@ -26,6 +32,7 @@ void BaseLevelManager::update() {
 
 	// Force pruning of all expired pointers
 	entities.validate();
+	occupancy.sync();
 
 	DBGEND("validate");
 	DBGSTART("cd");
@@ -39,17 +46,21 @@ void BaseLevelManager::update() {
 	// Apply game logic rules
 	std::vector<lif::Entity*> to_be_spawned;
 #ifndef RELEASE
-	int i = 0;
+	while (logicTimerIds.size() < logicFunctions.size()) {
+		const auto name = "logic_" + lif::to_string(logicTimerIds.size());
+		logicTimerIds.emplace_back(lif::debug::Tracer::intern(name.c_str()));
+	}
+	unsigned i = 0;
 #endif
 	for (const auto& logic : logicFunctions) {
 #ifndef RELEASE
-		std::stringstream n;
-		n << "logic_" << i;
-		dbgStats.timer.start(n.str());
+		dbgStats.timer.start(logicTimerIds[i]);
 #endif
-		entities.apply(logic, *this, to_be_spawned);
+		entities.forEachMatching(logic.query, [this, &logic, &to_be_spawned] (lif::Entity& e) {
+			logic.func(e, *this, to_be_spawned);
+		});
 #ifndef RELEASE
-		dbgStats.timer.end(n.str());
+		dbgStats.timer.end(logicTimerIds[i]);
 		++i;
 #endif
 	}
@@ -61,6 +72,11 @@ void BaseLevelManager::update() {
 
 	DBGSTART("ent_update");
 
+	// Remove the killed entities first, so their colliders don't linger in `occupancy`
+	// while entities update.
+	entities.checkAll();
+	occupancy.sync();
+
 	// Update entities and their components
 	entities.updateAll();
 
@@ -70,10 +86,19 @@ void BaseLevelManager::update() {
 
 void BaseLevelManager::_spawn(lif::Entity *e) {
 	entities.add(e);
+	// Fixed colliders are tracked automatically by `occupancy`, while non-moving
+	// ones (like explosions) need to be added explicitly.
+	if (e->get<lif::Fixed>() == nullptr && e->get<lif::Moving>() == nullptr) {
+		e->forEach<lif::Collider>([this] (const lif::Collider& cld) {
+			if (!cld.isPhantom())
+				occupancy.addTransient(cld);
+		});
+	}
 }
 
 void BaseLevelManager::reset() {
 	entities.clear();
+	occupancy.clear();
 }
 
 void BaseLevelManager::pause() {
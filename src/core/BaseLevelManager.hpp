@@ -1,14 +1,16 @@
 #pragma once
 
 #include "EntityGroup.hpp"
+#include "JobSystem.hpp"
+#include "OccupancyGrid.hpp"
 #include "SHCollisionDetector.hpp"
 #include <SFML/System/NonCopyable.hpp>
 #ifndef RELEASE
 #	include "Stats.hpp"
 #	define DBGSTART(name) \
-		dbgStats.timer.start(name)
+		dbgStats.timer.start(LIF_ZONE_ID(name))
 #	define DBGEND(name) \
-		dbgStats.timer.end(name)
+		dbgStats.timer.end(LIF_ZONE_ID(name))
 #else
 #	define DBGSTART(name)
 #	define DBGEND(name)
@@ -24,11 +26,21 @@ public:
 		std::vector<lif::Entity*>& // vector of entities to be spawned after calling game logic
 	)>;
 
+	/** A game logic rule, only applied to the entities matching `query` */
+	struct GameLogic {
+		GameLogicFunc func;
+		lif::EntityQuery query;
+	};
+
 protected:
+	/** Runs the concurrent part of the entities' update. Declared before `entities`, which uses it. */
+	lif::JobSystem jobs;
 	lif::EntityGroup entities;
 	lif::SHCollisionDetector cd;
+	/** Tile occupancy of the non-moving colliders, for fast per-tile queries */
+	lif::OccupancyGrid occupancy;
 
-	std::vector<GameLogicFunc> logicFunctions;
+	std::vector<GameLogic> logicFunctions;
 
 	bool paused = false;
 
@@ -37,6 +49,8 @@ protected:
 
 #ifndef RELEASE
 	lif::debug::Stats dbgStats;
+	/** The timer ids of the logic functions ("logic_0", "logic_1", ...) */
+	std::vector<lif::StringId> logicTimerIds;
 #endif
 
 	virtual void _spawn(lif::Entity *e);
@@ -47,6 +61,8 @@ public:
 	const lif::EntityGroup& getEntities() const { return entities; }
 	lif::EntityGroup& getEntities() { return entities; }
 	const lif::CollisionDetector& getCollisionDetector() const { return cd; }
+	const lif::OccupancyGrid& getOccupancy() const { return occupancy; }
+	const lif::JobSystem& getJobSystem() const { return jobs; }
 
 	/** Pauses all Clock components of all entities */
 	virtual void pause();
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+namespace lif {
+
+/**
+ * A drawable which can often be drawn as a single textured quad. Such quads can be collected
+ * into a vertex array and drawn together with all the others sharing the same texture
+ * (or the same atlas page, see lif::TextureAtlas), instead of costing a draw call each.
+ */
+class Batchable {
+public:
+	virtual ~Batchable() {}
+
+	/** If this can currently be drawn as a single quad, writes its 4 vertices (in the same order as
+	 *  sf::Quads, transformed in world coordinates) into `quad` and returns its texture.
+	 *  Otherwise returns nullptr, and this should be drawn as usual.
+	 */
+	virtual const sf::Texture* getBatchQuad(sf::Vertex *quad) const = 0;
+};
+
+}
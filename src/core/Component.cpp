@@ -3,5 +3,7 @@
 using lif::Component;
 
 Component::Component(lif::Entity& owner)
-	: owner(owner)
+	// Components don't need a stream of their own (see getRandom)
+	: lif::Entity(sf::Vector2f(0, 0), lif::Random())
+	, owner(owner)
 {}
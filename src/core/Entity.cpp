@@ -3,8 +3,11 @@
 #include "core.hpp"
 #include "Component.hpp"
 #include "utils.hpp"
+#include <atomic>
+#include <limits>
 #include <sstream>
 #include <iostream>
+#include <stdexcept>
 
 // Note: in theory, this should check for HAVE_CXA_DEMANGLE.
 // The GCC version that I'm using, though, despite being pretty recent (6.2.1),
@@ -34,10 +37,24 @@ static std::string demangle(const char *name) {
 
 using lif::Entity;
 
+lif::CompId lif::_nextCompId() {
+	static std::atomic<unsigned> nextId(0);
+	const auto id = nextId++;
+	if (id > std::numeric_limits<lif::CompId>::max())
+		throw std::logic_error("Too many component types!");
+	return static_cast<lif::CompId>(id);
+}
+
 Entity::Entity() : Entity({ 0, 0 }) {}
 
 Entity::Entity(const sf::Vector2f& pos)
-	: position(pos)
+	: random(lif::newRandomStream())
+	, position(pos)
+{}
+
+Entity::Entity(const sf::Vector2f& pos, const lif::Random& random)
+	: random(random)
+	, position(pos)
 {}
 
 Entity::~Entity() {}
@@ -45,6 +62,20 @@ Entity::~Entity() {}
 void Entity::_addUnique(lif::Component *c) {
 	if (std::find(compSet.begin(), compSet.end(), c) == compSet.end()) {
 		compSet.emplace_back(c);
+		if (c->isUpdatedConcurrently())
+			concurrentCompSet.emplace_back(c);
+	}
+}
+
+void Entity::_addToSlots(const std::shared_ptr<lif::Component>& comp) {
+	for (const auto key : comp->getKeys()) {
+		if (key >= components.size()) {
+			components.resize(key + 1);
+			compSlots.resize(key + 1, nullptr);
+		}
+		components[key].emplace_back(comp);
+		if (compSlots[key] == nullptr)
+			compSlots[key] = comp.get();
 	}
 }
 
@@ -74,11 +105,25 @@ lif::Entity* Entity::init() {
 }
 
 void Entity::update() {
+	if (updatedConcurrently) {
+		updatedConcurrently = false;
+		for (auto c : compSet)
+			if (c->isActive() && !c->isUpdatedConcurrently())
+				c->update();
+		return;
+	}
 	for (auto c : compSet)
 		if (c->isActive())
 			c->update();
 }
 
+void Entity::updateConcurrent() {
+	for (auto c : concurrentCompSet)
+		if (c->isActive())
+			c->update();
+	updatedConcurrently = true;
+}
+
 std::string Entity::_toString(int indent) const {
 	std::stringstream ss;
 	const auto put_indent = [&ss] (int indent) -> std::stringstream& {
@@ -89,7 +134,7 @@ std::string Entity::_toString(int indent) const {
 	put_indent(indent) << "[" << DEMANGLE(typeid(*this).name())
 		<< " @ " << position << " / " << lif::tile(position)
 		<< " ~ aligned = " << isAligned() << "]";
-	if (components.size() > 0) {
+	if (compSet.size() > 0) {
 		ss << "\r\n";
 		put_indent(indent) << "{\r\n";
 		for (auto c : compSet)
@@ -2,43 +2,79 @@
 
 #include <memory>
 #include <vector>
-#include <unordered_map>
 #include <typeinfo>
-#include <typeindex>
 #include <algorithm>
 #include <utility>
 #include <SFML/System.hpp>
 #include "Activable.hpp"
+#include "Handle.hpp"
+#include "Pool.hpp"
+#include "Random.hpp"
 #include "WithOrigin.hpp"
 #include "Stringable.hpp"
 
 namespace lif {
 
 class Component;
+class EntityGroup;
+
+/** Dense identifier of a Component type, used to index an Entity's component slots. */
+using CompId = unsigned short;
+
+/** @return A never-used CompId. Only meant to be called by `compId<T>()`. */
+CompId _nextCompId();
+
+/** @return The CompId of component type T. Ids are assigned on first use,
+ *  so they're consistent within a single run of the program but not across runs.
+ */
+template<class T>
+inline CompId compId() {
+	static const CompId id = lif::_nextCompId();
+	return id;
+}
 
 /**
  * Base class for game entities (walls, enemies, players, ...)
  */
 class Entity : public lif::WithOrigin, public lif::Stringable {
+	friend class lif::EntityGroup;
+
 protected:
-	using CompKey = std::type_index;
+	using CompKey = lif::CompId;
 	using CompVec = std::vector<std::shared_ptr<lif::Component>>;
 
 private:
 	/** Used internally to fastly iterate over components only once. This is set up by init() */
 	std::vector<lif::Component*> compSet;
-	std::unordered_map<CompKey, CompVec> components;
+	/** The components of compSet which are updated concurrently (see Component::isUpdatedConcurrently) */
+	std::vector<lif::Component*> concurrentCompSet;
+	/** Whether updateConcurrent() was called since the last update() */
+	bool updatedConcurrently = false;
+	/** The first component added for each key, indexed by key (nullptr if there's none).
+	 *  This is what makes get<T>() a plain index load.
+	 */
+	std::vector<lif::Component*> compSlots;
+	/** All the components added for each key, indexed by key */
+	std::vector<CompVec> components;
 	bool _initialized = false;
+	/** This entity's handle in the EntityGroup it was added to (a null handle if it's in none) */
+	lif::Handle<lif::Entity> handle;
+	/** This entity's own stream of random numbers (see getRandom) */
+	lif::Random random;
 
 	std::string _toString(int indent) const;
 	void _addUnique(lif::Component *c);
+	void _addToSlots(const std::shared_ptr<lif::Component>& comp);
 
 protected:
 	sf::Vector2f position;
 
+	/** Constructs the entity with the given random stream rather than a new one */
+	explicit Entity(const sf::Vector2f& pos, const lif::Random& random);
+
 	template<class T>
-	std::type_index _getKey() const {
-		return std::type_index(typeid(T));
+	static CompKey _getKey() {
+		return lif::compId<T>();
 	}
 
 public:
@@ -62,6 +98,9 @@ public:
 	template<class T>
 	T* get() const;
 
+	/** @return Whether this entity has a component whose CompId (or one of its superclasses') is `id` */
+	bool has(lif::CompId id) const { return id < compSlots.size() && compSlots[id] != nullptr; }
+
 	/** @return A shared pointer to the first component of type T added to this entity */
 	template<class T>
 	std::shared_ptr<T> getShared() const;
@@ -74,12 +113,27 @@ public:
 	template<class T>
 	std::vector<std::shared_ptr<T>> getAllShared() const;
 
+	/** Calls `func(T&)` on all components of type T whose owner is this entity.
+	 *  Unlike `getAll`, this does not allocate, so it's preferable in code running every frame.
+	 */
+	template<class T, class F>
+	void forEach(const F& func) const;
+
 	/** @return Unowning pointers to all components of type T belonging to this entity and to all its components,
 	 *  recursively. This method is expensive, so it should not be called frequently.
 	 */
 	template<class T>
 	std::vector<T*> getAllRecursive() const;
 
+	/** @return This entity's handle in its EntityGroup (a null handle if it's in none) */
+	lif::Handle<lif::Entity> getHandle() const { return handle; }
+
+	/** @return This entity's random number generator, which is only used by it and its components.
+	 *  Each entity gets a new stream (see lif::newRandomStream), so, given the level's seed, its
+	 *  random choices only depend on the order in which the entities were created.
+	 */
+	lif::Random& getRandom() { return random; }
+
 	/** Called after the constructor; all components should have been already
 	 *  added at this time.
 	 *  Note: this method is automatically invoked by EntityGroup::add.
@@ -89,6 +143,11 @@ public:
 	virtual lif::Entity* init();
 	/** Called every frame */
 	virtual void update();
+	/** Updates the components which may be updated concurrently with other entities (see
+	 *  Component::isUpdatedConcurrently), so that the following update() skips them.
+	 *  Called by EntityGroup::updateAll before updating the entities.
+	 */
+	void updateConcurrent();
 
 	/** Implements WithOrigin */
 	virtual void setOrigin(const sf::Vector2f& origin) override;
@@ -118,6 +177,13 @@ protected:
 	 *  so it can be queried via its subclasses with Entity::get().
 	 */
 	std::vector<CompKey> keys;
+	/** If true, this component's update() may be called concurrently with other entities' ones,
+	 *  before any other update of the frame. Such components may read other entities, as long as
+	 *  they don't read what the other concurrently updated components write, but may only write
+	 *  their own state: anything else (moving, spawning, playing sounds, ...) must be done in a
+	 *  regular update. Must be set by the constructor.
+	 */
+	bool concurrentUpdate = false;
 
 	template<class T>
 	void _declComponent() { keys.emplace_back(_getKey<T>()); }
@@ -134,7 +200,12 @@ public:
 	/** Gets the owner of this component (non-const) */
 	lif::Entity& getOwnerRW() const { return owner; }
 
-	std::vector<CompKey> getKeys() const { return keys; }
+	/** Components use their owner's random stream */
+	lif::Random& getRandom() { return owner.getRandom(); }
+
+	const std::vector<CompKey>& getKeys() const { return keys; }
+
+	bool isUpdatedConcurrently() const { return concurrentUpdate; }
 };
 
 #include "Entity.inl"
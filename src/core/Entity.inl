@@ -6,36 +6,36 @@ T* Entity::addComponent(const std::shared_ptr<T>& comp) {
 		throw std::logic_error("Two components of type " +
 				std::string(typeid(T).name()) + " were added to this Entity!");
 	_addUnique(comp.get());
-	for (const auto& t : comp->getKeys())
-		components[t].emplace_back(comp);
+	_addToSlots(comp);
 	return comp.get();
 }
 
 template<class T, class... Args>
 T* Entity::addComponent(Args&&... args) {
-	return addComponent(std::make_shared<T>(std::forward<Args>(args)...));
+	return addComponent(std::allocate_shared<T>(lif::PoolAllocator<T>(), std::forward<Args>(args)...));
 }
 
 template<class T>
 std::shared_ptr<T> Entity::getShared() const {
-	auto comp = components.find(_getKey<T>());
-	if (comp == components.end() || comp->second.size() == 0)
+	const auto key = _getKey<T>();
+	if (key >= components.size() || components[key].size() == 0)
 		return std::shared_ptr<T>();
-	return std::static_pointer_cast<T>(comp->second[0]);
+	return std::static_pointer_cast<T>(components[key][0]);
 }
 
 template<class T>
 T* Entity::get() const {
-	return getShared<T>().get();
+	const auto key = _getKey<T>();
+	return key < compSlots.size() ? static_cast<T*>(compSlots[key]) : nullptr;
 }
 
 template<class T>
 std::vector<std::shared_ptr<T>> Entity::getAllShared() const {
 	std::vector<std::shared_ptr<T>> comps;
-	auto pair = components.find(_getKey<T>());
-	if (pair == components.end())
+	const auto key = _getKey<T>();
+	if (key >= components.size())
 		return comps;
-	auto& compVec = pair->second;
+	auto& compVec = components[key];
 	std::for_each(compVec.begin(), compVec.end(), [&comps] (const std::shared_ptr<lif::Component>& c) {
 		comps.emplace_back(std::static_pointer_cast<T>(c));
 	});
@@ -45,16 +45,26 @@ std::vector<std::shared_ptr<T>> Entity::getAllShared() const {
 template<class T>
 std::vector<T*> Entity::getAll() const {
 	std::vector<T*> comps;
-	auto pair = components.find(_getKey<T>());
-	if (pair == components.end())
+	const auto key = _getKey<T>();
+	if (key >= components.size())
 		return comps;
-	auto& compVec = pair->second;
+	auto& compVec = components[key];
 	std::for_each(compVec.begin(), compVec.end(), [&comps] (const std::shared_ptr<lif::Component>& c) {
 		comps.emplace_back(static_cast<T*>(c.get()));
 	});
 	return comps;
 }
 
+template<class T, class F>
+void Entity::forEach(const F& func) const {
+	const auto key = _getKey<T>();
+	if (key >= components.size())
+		return;
+	auto& compVec = components[key];
+	for (unsigned i = 0; i < compVec.size(); ++i)
+		func(*static_cast<T*>(compVec[i].get()));
+}
+
 template<class T>
 std::vector<T*> Entity::getAllRecursive() const {
 	std::vector<T*> all;
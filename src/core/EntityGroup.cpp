@@ -1,22 +1,40 @@
 #include "EntityGroup.hpp"
 #include "Component.hpp"
+#include "Drawable.hpp"
+#include "JobSystem.hpp"
 #include "Killable.hpp"
+#include "ZIndexed.hpp"
 #include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 
 using lif::EntityGroup;
 
+static bool drawOrder(const lif::DrawItem& a, const lif::DrawItem& b) {
+	return a.z < b.z || (a.z == b.z && a.seq < b.seq);
+}
+
 EntityGroup::EntityGroup() {}
 
+EntityGroup::~EntityGroup() {
+	// Entities may outlive the group: don't leave them with handles into it
+	clear();
+}
+
 void EntityGroup::validate() {
 	_pruneAll();
 	alreadyPrunedThisUpdate = true;
 }
 
 void EntityGroup::checkAll() {
+	const auto prevSize = entities.size();
 	_checkDead();
 	_checkKilled();
+	_compact();
+	// Don't leave expired colliders around until the next validate() if something was destroyed
+	if (entities.size() != prevSize)
+		_pruneAll();
 	alreadyCheckedThisUpdate = true;
 }
 
@@ -27,6 +45,9 @@ void EntityGroup::updateAll() {
 	if (!alreadyPrunedThisUpdate)
 		_pruneAll();
 
+	tileIndex.rebuild(entities);
+
+	_updateConcurrent();
 	for (auto& e : entities)
 		e->update();
 
@@ -34,38 +55,80 @@ void EntityGroup::updateAll() {
 	alreadyCheckedThisUpdate = false;
 }
 
-void EntityGroup::remove(const lif::Entity& entity) {
-	std::remove_if(entities.begin(), entities.end(), [entity] (const auto& e) {
-		return e.get() == &entity;
+void EntityGroup::_updateConcurrent() {
+	// Most entities have no concurrent component, so make the chunks big enough to be
+	// worth a thread's time.
+	constexpr std::size_t GRAIN = 64;
+
+	if (jobs == nullptr) {
+		for (auto& e : entities)
+			e->updateConcurrent();
+		return;
+	}
+	jobs->parallelFor(entities.size(), GRAIN, [this] (std::size_t begin, std::size_t end) {
+		for (auto i = begin; i < end; ++i)
+			entities[i]->updateConcurrent();
 	});
+}
+
+void EntityGroup::remove(const lif::Entity& entity) {
+	// Only look up the non-const entity through its handle, so we never touch one in another group
+	auto e = entitySlots.get(entity.handle);
+	if (e != &entity)
+		return;
+	_markRemoved(*e);
+	_compact();
 	_pruneAll();
 }
 
 void EntityGroup::remove(const std::shared_ptr<const lif::Entity>& entity) {
-	std::remove(entities.begin(), entities.end(), entity);
-	_pruneAll();
+	remove(*entity);
 }
 
 auto EntityGroup::getCollidersIntersecting(const sf::FloatRect& rect) const -> std::vector<lif::Collider*> {
 	std::vector<lif::Collider*> clds;
 	clds.reserve(collidingEntities.size());
-	for (auto& e : collidingEntities) {
-		if (e.expired()) continue;
-		auto cld = e.lock();
-		if (cld->getRect().intersects(rect))
-			clds.emplace_back(cld.get());
+	for (auto h : collidingEntities) {
+		auto cld = colliderSlots.get(h);
+		if (cld != nullptr && cld->getRect().intersects(rect))
+			clds.emplace_back(cld);
 	}
 	return clds;
 }
 
 void EntityGroup::clear() {
+	for (auto& e : entities)
+		_releaseHandles(*e);
+	entitySlots.clear();
+	colliderSlots.clear();
 	entities.clear();
+	mustCompact = false;
 	collidingEntities.clear();
+	fixedColliders.clear();
+	dynamicColliders.clear();
+	++fixedCollidersGeneration;
+	tileIndex.clear();
+	for (auto& index : queryIndices)
+		index.entities.clear();
+	mustPruneQueries = false;
+	drawList.clear();
+	newDrawItems.clear();
+	mustPruneDrawList = mustSortDrawList = false;
+}
+
+#ifndef RELEASE
+void EntityGroup::_checkNotInJob() {
+	if (lif::JobSystem::inJob())
+		throw std::logic_error("Entities must not be added by concurrent updates!");
 }
+#endif
 
 lif::Entity* EntityGroup::add(lif::Entity *entity) {
+#ifndef RELEASE
+	_checkNotInJob();
+#endif
 	entity->init();
-	entities.emplace_back(entity);
+	entities.emplace_back(entity, std::default_delete<lif::Entity>(), lif::PoolAllocator<lif::Entity>());
 	return _putInAux(entities.back().get());
 }
 
@@ -76,23 +139,133 @@ lif::Entity* EntityGroup::_putInAux(lif::Entity *entity) {
 		killables.emplace_back(klb);
 	}
 
-	for (auto cld : entity->getAllShared<lif::Collider>()) {
-		if (cld != nullptr && !cld->isPhantom()) {
-			collidingEntities.emplace_back(cld);
-		}
+	entity->handle = entitySlots.insert(entity);
+
+	for (auto& index : queryIndices)
+		if (index.query.matches(*entity))
+			index.entities.emplace_back(entity->handle);
+
+	const bool fixed = entity->get<lif::Fixed>() != nullptr;
+	entity->forEach<lif::Collider>([this, fixed] (lif::Collider& cld) {
+		if (cld.isPhantom()) return;
+		cld.handle = colliderSlots.insert(&cld);
+		cld.registry = &colliderSlots;
+		collidingEntities.emplace_back(cld.handle);
+		if (fixed)
+			fixedColliders.emplace_back(cld.handle);
+		else
+			dynamicColliders.emplace_back(cld.handle);
+	});
+
+	const auto drawable = entity->get<lif::Drawable>();
+	if (drawable != nullptr) {
+		const auto zidx = entity->get<lif::ZIndexed>();
+		if (zidx != nullptr)
+			zidx->setOnChange([this] () { mustSortDrawList = true; });
+		newDrawItems.push_back({
+			zidx != nullptr ? zidx->getZIndex() : 0,
+			nextDrawSeq++,
+			drawable,
+			zidx,
+			entity->get<lif::Moving>(),
+			entity->handle
+		});
 	}
 
 	return entity;
 }
 
+void EntityGroup::_releaseHandles(lif::Entity& entity) {
+	// Its draw list item (if any) is now stale
+	mustPruneDrawList = true;
+	mustPruneQueries = true;
+	entity.forEach<lif::ZIndexed>([] (lif::ZIndexed& zidx) { zidx.setOnChange(nullptr); });
+	entitySlots.release(entity.handle);
+	entity.handle = lif::Handle<lif::Entity>();
+	entity.forEach<lif::Collider>([this] (lif::Collider& cld) {
+		if (cld.registry != &colliderSlots) return;
+		colliderSlots.release(cld.handle);
+		cld.handle = lif::Handle<lif::Collider>();
+		cld.registry = nullptr;
+		cld.colliding.clear();
+	});
+}
+
+auto EntityGroup::getDrawList() -> const std::vector<lif::DrawItem>& {
+	// Prune first, so we never touch the components of removed entities
+	if (mustPruneDrawList) {
+		const auto removed = [this] (const lif::DrawItem& item) {
+			return entitySlots.get(item.entity) == nullptr;
+		};
+		drawList.erase(std::remove_if(drawList.begin(), drawList.end(), removed), drawList.end());
+		newDrawItems.erase(std::remove_if(newDrawItems.begin(), newDrawItems.end(), removed),
+				newDrawItems.end());
+		mustPruneDrawList = false;
+	}
+
+	if (mustSortDrawList) {
+		for (auto& item : drawList)
+			item.z = item.zIndexed != nullptr ? item.zIndexed->getZIndex() : 0;
+		for (auto& item : newDrawItems)
+			item.z = item.zIndexed != nullptr ? item.zIndexed->getZIndex() : 0;
+		std::sort(drawList.begin(), drawList.end(), drawOrder);
+		mustSortDrawList = false;
+	}
+
+	if (newDrawItems.size() > 0) {
+		std::sort(newDrawItems.begin(), newDrawItems.end(), drawOrder);
+		drawListBuffer.clear();
+		drawListBuffer.reserve(drawList.size() + newDrawItems.size());
+		std::merge(drawList.begin(), drawList.end(), newDrawItems.begin(), newDrawItems.end(),
+				std::back_inserter(drawListBuffer), drawOrder);
+		drawList.swap(drawListBuffer);
+		newDrawItems.clear();
+	}
+
+	return drawList;
+}
+
 void EntityGroup::_pruneAll() {
 	_pruneColliding();
+	_pruneQueries();
+}
+
+void EntityGroup::_pruneQueries() {
+	if (!mustPruneQueries)
+		return;
+	const auto expired = [this] (lif::Handle<lif::Entity> h) { return entitySlots.get(h) == nullptr; };
+	for (auto& index : queryIndices)
+		index.entities.erase(std::remove_if(index.entities.begin(), index.entities.end(), expired),
+				index.entities.end());
+	mustPruneQueries = false;
+}
+
+std::size_t EntityGroup::_getQueryIndex(const lif::EntityQuery& query) {
+	for (std::size_t i = 0; i < queryIndices.size(); ++i)
+		if (queryIndices[i].query == query)
+			return i;
+
+	QueryIndex index;
+	index.query = query;
+	for (const auto& e : entities)
+		if (query.matches(*e))
+			index.entities.emplace_back(e->handle);
+	queryIndices.emplace_back(std::move(index));
+	return queryIndices.size() - 1;
 }
 
 void EntityGroup::_pruneColliding() {
-	collidingEntities.erase(std::remove_if(collidingEntities.begin(), collidingEntities.end(), [] (auto it) {
-		return it.expired();
-	}), collidingEntities.end());
+	const auto expired = [this] (lif::Handle<lif::Collider> h) { return colliderSlots.get(h) == nullptr; };
+	collidingEntities.erase(std::remove_if(collidingEntities.begin(), collidingEntities.end(), expired),
+			collidingEntities.end());
+	dynamicColliders.erase(std::remove_if(dynamicColliders.begin(), dynamicColliders.end(), expired),
+			dynamicColliders.end());
+
+	const auto fixedEnd = std::remove_if(fixedColliders.begin(), fixedColliders.end(), expired);
+	if (fixedEnd != fixedColliders.end()) {
+		fixedColliders.erase(fixedEnd, fixedColliders.end());
+		++fixedCollidersGeneration;
+	}
 }
 
 void EntityGroup::_checkKilled() {
@@ -112,14 +285,7 @@ void EntityGroup::_checkKilled() {
 				continue;
 			}
 
-			auto eit = std::find_if(entities.begin(), entities.end(),
-				[klb] (const std::shared_ptr<lif::Entity>& ptr)
-			{
-				return ptr.get() == &klb->getOwner();
-			});
-			if (eit != entities.end()) {
-				entities.erase(eit);
-			}
+			_markRemoved(klb->getOwnerRW());
 			// erase
 
 		} else {
@@ -140,12 +306,7 @@ void EntityGroup::_checkDead() {
 		auto tmp = it->lock();
 		if (!tmp->isKillInProgress()) {
 			// kill function has ended, we can safely destroy this.
-			auto eit = std::find_if(entities.begin(), entities.end(), [tmp] (const auto& ptr) {
-				return ptr.get() == &tmp->getOwner();
-			});
-			if (eit != entities.end()) {
-				entities.erase(eit);
-			}
+			_markRemoved(tmp->getOwnerRW());
 
 		} else {
 			if (it != w)
@@ -155,3 +316,21 @@ void EntityGroup::_checkDead() {
 	}
 	dying.erase(w, dying.end());
 }
+
+void EntityGroup::_markRemoved(lif::Entity& entity) {
+	// Entities which already left the group have a released handle
+	if (entitySlots.get(entity.handle) != &entity)
+		return;
+	_releaseHandles(entity);
+	mustCompact = true;
+}
+
+void EntityGroup::_compact() {
+	if (!mustCompact)
+		return;
+	// The entities in the group are exactly those with a valid handle
+	entities.erase(std::remove_if(entities.begin(), entities.end(), [] (const auto& e) {
+		return e->handle.isNull();
+	}), entities.end());
+	mustCompact = false;
+}
@@ -2,10 +2,12 @@
 
 #include "Collider.hpp"
 #include "Entity.hpp"
+#include "EntityQuery.hpp"
 #include "Fixed.hpp"
 #include "Killable.hpp"
 #include "Moving.hpp"
 #include "Temporary.hpp"
+#include "TileIndex.hpp"
 #include <SFML/System/NonCopyable.hpp>
 #include <algorithm>
 #include <array>
@@ -19,7 +21,23 @@
 namespace lif {
 
 class CollisionDetector;
+class Drawable;
+class JobSystem;
 class LevelRenderer;
+class ZIndexed;
+
+/** An element of an EntityGroup's draw list */
+struct DrawItem {
+	int z;
+	/** Order of addition to the group: items with the same z are drawn in this order */
+	unsigned seq;
+	const lif::Drawable *drawable;
+	/** The owner's ZIndexed, if any */
+	const lif::ZIndexed *zIndexed;
+	/** The owner's Moving, if any */
+	const lif::Moving *moving;
+	lif::Handle<lif::Entity> entity;
+};
 
 /**
  * A container for Entities, providing convenient methods for operating
@@ -33,8 +51,24 @@ class EntityGroup final : private sf::NonCopyable {
 	/** All the entities (owning references) */
 	std::vector<std::shared_ptr<lif::Entity>> entities;
 
+	/** Handles to the entities in this group and to their non-phantom colliders.
+	 *  Handles are released as soon as their entity leaves the group, so that checking
+	 *  whether a collider still exists doesn't need to touch any reference count.
+	 */
+	lif::SlotTable<lif::Entity> entitySlots;
+	lif::SlotTable<lif::Collider> colliderSlots;
+
 	/** The colliders of entities which have one */
-	std::vector<std::weak_ptr<lif::Collider>> collidingEntities;
+	std::vector<lif::Handle<lif::Collider>> collidingEntities;
+
+	/** The subset of `collidingEntities` whose owner is Fixed. Since these never move,
+	 *  the collision detector keeps them in a persistent structure.
+	 */
+	std::vector<lif::Handle<lif::Collider>> fixedColliders;
+	/** The subset of `collidingEntities` whose owner is not Fixed */
+	std::vector<lif::Handle<lif::Collider>> dynamicColliders;
+	/** Incremented every time some collider is removed from `fixedColliders` */
+	unsigned fixedCollidersGeneration = 0;
 
 	/** The vector of the killable entities, which ought to be removed when
 	 *  their `isKilled()` method yields true.
@@ -46,6 +80,36 @@ class EntityGroup final : private sf::NonCopyable {
 	 */
 	std::vector<std::weak_ptr<lif::Killable>> dying;
 
+	/** Which entities are on which tile, as of the beginning of the latest `updateAll()` */
+	lif::TileIndex tileIndex;
+
+	/** The entities matching a query, in order of addition (see `forEachMatching`) */
+	struct QueryIndex {
+		lif::EntityQuery query;
+		std::vector<lif::Handle<lif::Entity>> entities;
+	};
+	/** The indices of all the queries used so far. There are only a few of them, so they're
+	 *  looked up linearly.
+	 */
+	std::vector<QueryIndex> queryIndices;
+	/** Set when some entity left the group, so the query indices contain stale handles */
+	bool mustPruneQueries = false;
+	/** Set when some entity in `entities` was marked as removed (see `_markRemoved`) */
+	bool mustCompact = false;
+
+	/** Runs the concurrent phase of `updateAll()`, if not null */
+	lif::JobSystem *jobs = nullptr;
+
+	/** The drawable entities sorted by (z, seq). It is brought up to date lazily by `getDrawList()`. */
+	std::vector<lif::DrawItem> drawList;
+	/** Items of the entities added since the latest `getDrawList()` */
+	std::vector<lif::DrawItem> newDrawItems;
+	/** Scratch buffer used to merge `newDrawItems` into `drawList` */
+	std::vector<lif::DrawItem> drawListBuffer;
+	unsigned nextDrawSeq = 0;
+	/** Set when some entity left the group, or when some z-index changed */
+	bool mustPruneDrawList = false,
+	     mustSortDrawList = false;
 
 	/** Removes any killed entity from all internal collections (including the main one) and destroys them.
 	 *  If its `isKillInProgress()` is true, puts it in `dying`
@@ -57,14 +121,38 @@ class EntityGroup final : private sf::NonCopyable {
 	 */
 	void _checkDead();
 
+	/** Releases the handles of `entity`, if it's in this group, marking it for removal
+	 *  from `entities` by the next `_compact()`.
+	 */
+	void _markRemoved(lif::Entity& entity);
+	/** Removes (and destroys, unless shared) all the entities marked by `_markRemoved` in a single
+	 *  pass, keeping the others in order of addition.
+	 */
+	void _compact();
+
 	/** Iterate over aux collections and remove all expired weak pointers.
 	 *  Note that, differently from the `_check*` methods, the `_prune*` ones do NOT
 	 *  affect the main `entities` collection.
 	 */
 	void _pruneAll();
 	void _pruneColliding();
+	void _pruneQueries();
+
+	/** @return The position in `queryIndices` of the index of `query`, creating it if needed */
+	std::size_t _getQueryIndex(const lif::EntityQuery& query);
 
+	/** Calls `updateConcurrent` for every entity, using `jobs` if set */
+	void _updateConcurrent();
+
+#ifndef RELEASE
+	/** Throws if called from inside a job, where entities must not be added */
+	static void _checkNotInJob();
+#endif
 	lif::Entity* _putInAux(lif::Entity *entity);
+	/** Releases the handles of `entity` and of its colliders. Must be called whenever an entity
+	 *  leaves the group.
+	 */
+	void _releaseHandles(lif::Entity& entity);
 public:
 	static constexpr bool APPLY_PROCEED = false;
 	static constexpr bool APPLY_EXIT = true;
@@ -73,6 +161,7 @@ public:
 	 * Constructs the EntityGroup as the owner of its entities.
 	 */
 	explicit EntityGroup();
+	~EntityGroup();
 
 	/** Applies a function to all entities.
 	 *  If the passed function returns APPLY_EXIT for an Entity,
@@ -120,7 +209,18 @@ public:
 			func(*e, std::forward<Args>(args)...);
 	}
 
-	/** Adds an entity to this group. */
+	/** Calls `func(lif::Entity&)` on all the entities matching `query`, in order of addition.
+	 *  The first time a query is used, the group starts keeping an index of its matches, so that
+	 *  later calls only visit those: the cost depends on the matching entities, not on all of them.
+	 *  Entities are matched when they're added, so components added afterwards are not considered.
+	 *  Entities added by `func` are not visited.
+	 */
+	template<typename F>
+	void forEachMatching(const lif::EntityQuery& query, const F& func);
+
+	/** Adds an entity to this group, taking ownership of it.
+	 *  The shared_ptr's control block is taken from the lif::pool size classes.
+	 */
 	lif::Entity* add(lif::Entity *entity);
 
 	/** @see add */
@@ -153,19 +253,55 @@ public:
 	 *  something in its last update cycle between a call to `validate()` and `updateAll()`.
 	 */
 	void validate();
-	/** Explicitly request that the internal helper lists are updated. */
+	/** Explicitly request that the internal helper lists are updated.
+	 *  This removes killed and dead entities from the main collection (and prunes the
+	 *  aux collections if anything was removed).
+	 */
 	void checkAll();
-	/** Calls `update` for every entity in this group */
+	/** Updates every entity in this group in two phases: first the components which can be
+	 *  updated concurrently (see Component::isUpdatedConcurrently) for all entities, spread over
+	 *  the JobSystem's threads, then everything else, serially and in order of addition.
+	 */
 	void updateAll();
+	/** Sets the JobSystem used by `updateAll` (if null, everything is updated by the calling thread) */
+	void setJobSystem(lif::JobSystem *js) { jobs = js; }
 
-	auto getColliding() -> std::vector<std::weak_ptr<lif::Collider>>& {
+	/** @return The handles of all the colliders (use `get` to access them) */
+	auto getColliding() const -> const std::vector<lif::Handle<lif::Collider>>& {
 		return collidingEntities;
 	}
 
-	auto getColliding() const -> const std::vector<std::weak_ptr<lif::Collider>>& {
-		return collidingEntities;
+	/** @return The colliders whose owner is Fixed. New ones are always appended at the end,
+	 *  so a user can track them incrementally until `getFixedCollidersGeneration()` changes.
+	 */
+	auto getFixedColliders() const -> const std::vector<lif::Handle<lif::Collider>>& {
+		return fixedColliders;
+	}
+
+	/** @return A number which changes every time some fixed collider is removed */
+	unsigned getFixedCollidersGeneration() const { return fixedCollidersGeneration; }
+
+	/** @return The colliders whose owner is not Fixed */
+	auto getDynamicColliders() const -> const std::vector<lif::Handle<lif::Collider>>& {
+		return dynamicColliders;
 	}
 
+	/** @return The entity referenced by `handle`, or nullptr if it has left this group */
+	lif::Entity* get(lif::Handle<lif::Entity> handle) const { return entitySlots.get(handle); }
+	/** @return The collider referenced by `handle`, or nullptr if its owner has left this group */
+	lif::Collider* get(lif::Handle<lif::Collider> handle) const { return colliderSlots.get(handle); }
+
+	/** @return An index of the entities by tile. It is rebuilt by `updateAll()` right before
+	 *  updating the entities, so it does not reflect the movements happened during the update itself.
+	 */
+	const lif::TileIndex& getTileIndex() const { return tileIndex; }
+
+	/** @return The entities having a Drawable, sorted by z-index and, for equal z-index, by order of addition.
+	 *  The list is kept across calls and only updated for the entities added or removed and the
+	 *  z-indexes changed in between, so calling this every frame doesn't allocate.
+	 */
+	auto getDrawList() -> const std::vector<lif::DrawItem>&;
+
 	/** @return all colliders intersecting `rect`.
 	 *  NOTE: these pointers are only guaranteed to be valid until the next call to updateAll(), so
 	 *  the caller should *not* retain them.
@@ -177,6 +313,9 @@ public:
 
 template<typename T>
 T* EntityGroup::add(std::shared_ptr<T> entity) {
+#ifndef RELEASE
+	_checkNotInJob();
+#endif
 	entity->init();
 	entities.emplace_back(entity);
 	return static_cast<T*>(_putInAux(entities.back().get()));
@@ -184,9 +323,26 @@ T* EntityGroup::add(std::shared_ptr<T> entity) {
 
 template<typename T, typename...Args>
 T* EntityGroup::add(Args&&... args) {
-	entities.emplace_back(std::make_shared<T>(std::forward<Args>(args)...));
-	entities.back()->init();
-	return static_cast<T*>(_putInAux(entities.back().get()));
+	// Use `new` rather than make_shared, so that T's own operator new (if any) is used
+	return static_cast<T*>(add(new T(std::forward<Args>(args)...)));
+}
+
+template<typename F>
+void EntityGroup::forEachMatching(const lif::EntityQuery& query, const F& func) {
+	if (query.matchesAll()) {
+		const auto n = entities.size();
+		for (std::size_t i = 0; i < n; ++i)
+			func(*entities[i]);
+		return;
+	}
+	// `queryIndices` may grow while calling `func`, so don't hold references into it
+	const auto idx = _getQueryIndex(query);
+	const auto n = queryIndices[idx].entities.size();
+	for (std::size_t i = 0; i < n; ++i) {
+		auto entity = entitySlots.get(queryIndices[idx].entities[i]);
+		if (entity != nullptr)
+			func(*entity);
+	}
 }
 
 template<typename T>
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Entity.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace lif {
+
+/**
+ * A component signature: an entity matches it if it has at least one component of each
+ * of its types. Used with EntityGroup::forEachMatching to only visit the entities
+ * some piece of logic is interested in. The empty query matches all entities.
+ */
+class EntityQuery final {
+	/** The CompIds of the required components, sorted and without duplicates */
+	std::vector<lif::CompId> required;
+
+public:
+	/** @return A query matching the entities having all of `Comps` */
+	template<class... Comps>
+	static EntityQuery of() {
+		EntityQuery query;
+		query.required = { lif::compId<Comps>()... };
+		std::sort(query.required.begin(), query.required.end());
+		query.required.erase(std::unique(query.required.begin(), query.required.end()),
+				query.required.end());
+		return query;
+	}
+
+	bool matches(const lif::Entity& entity) const {
+		return std::all_of(required.begin(), required.end(), [&entity] (lif::CompId id) {
+			return entity.has(id);
+		});
+	}
+
+	/** @return Whether this query matches every entity, i.e. it requires no component */
+	bool matchesAll() const { return required.empty(); }
+
+	bool operator==(const EntityQuery& other) const { return required == other.required; }
+};
+
+}
@@ -1,26 +1,143 @@
 #include "GameCache.hpp"
+#include "JobSystem.hpp"
 #include "Options.hpp"
 #include "core.hpp"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 using lif::GameCache;
 
-GameCache::GameCache() {}
+/** The asset loaders are not meant to compete with the main thread for the CPU */
+constexpr unsigned MAX_LOADER_THREADS = 2;
+/** Default memory budgets: far above what a single level needs */
+constexpr std::size_t DEFAULT_CPU_BUDGET = 128 << 20;
+constexpr std::size_t DEFAULT_GPU_BUDGET = 512 << 20;
+
+static bool isDone(const std::future<void>& future) {
+	return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+/** Loads `asset` from `archive` if it's packed there, else from its file `name` */
+template<class T>
+static bool loadAsset(T& asset, const lif::AssetArchive& archive, const std::string& name) {
+	const auto data = archive.find(name);
+	return data ? asset.loadFromMemory(data.data, data.size) : asset.loadFromFile(name);
+}
+
+/** Textures are assumed to be stored as RGBA8; a full mipmap chain takes 1/3 more */
+static std::size_t textureBytes(const sf::Texture& texture, bool mipmapped) {
+	const auto size = texture.getSize();
+	const auto bytes = std::size_t(size.x) * size.y * 4;
+	return mipmapped ? bytes + bytes / 3 : bytes;
+}
+
+static std::size_t pagesBytes(const lif::TextureAtlas& atlas, bool mipmapped) {
+	std::size_t bytes = 0;
+	for (unsigned i = 0; i < atlas.getPagesCount(); ++i)
+		bytes += textureBytes(atlas.getPage(i), mipmapped);
+	return bytes;
+}
+
+GameCache::GameCache()
+	: cpuBudget(DEFAULT_CPU_BUDGET)
+	, gpuBudget(DEFAULT_GPU_BUDGET)
+{}
 
 void GameCache::setMaxParallelSounds(std::size_t n) {
 	maxParallelSounds = n;
 }
 
-sf::Texture* GameCache::loadTexture(const std::string& textureName) {
+bool GameCache::openArchive(const std::string& path, const std::string& rootDir) {
+	if (!archive.open(path, rootDir))
+		return false;
+#ifndef RELEASE
+	std::cerr << "[GameCache] Opened asset archive " << path << " ("
+		<< archive.getEntriesCount() << " entries)" << std::endl;
+#endif
+	return true;
+}
+
+void GameCache::setMipmapping(bool b) {
+	if (b == mipmapping)
+		return;
+	mipmapping = b;
+	if (!mipmapping || headless)
+		return;
+
+	// Textures loaded so far have no mipmaps yet
+	texturesBytes = 0;
+	for (auto& pair : textures) {
+		auto& entry = pair.second;
+		if (entry.asset.getSize().x == 0)
+			continue;
+		entry.bytes = textureBytes(entry.asset, entry.asset.generateMipmap());
+		texturesBytes += entry.bytes;
+	}
+	atlas.generateMipmaps();
+	atlasBytes = pagesBytes(atlas, true);
+	_enforceBudget();
+}
+
+void GameCache::setMemoryBudget(std::size_t cpuBytes, std::size_t gpuBytes) {
+	cpuBudget = cpuBytes;
+	gpuBudget = gpuBytes;
+	_enforceBudget();
+}
+
+lif::ThreadPool& GameCache::_getLoaders() {
+	if (loaders == nullptr) {
+		const auto hwThreads = std::thread::hardware_concurrency();
+		loaders.reset(new lif::ThreadPool(std::min(MAX_LOADER_THREADS, hwThreads > 1 ? hwThreads - 1 : 1)));
+	}
+	return *loaders;
+}
+
+GameCache::Entry<sf::Texture>& GameCache::_addTexture(lif::StringId nameSid) {
+	auto& entry = textures[nameSid];
+	entry.lastUse = ++useClock;
+	textureIds[&entry.asset] = nameSid;
+	return entry;
+}
+
+void GameCache::_accountTexture(Entry<sf::Texture>& entry) {
+	const bool mipmapped = mipmapping && entry.asset.generateMipmap();
+	entry.bytes = textureBytes(entry.asset, mipmapped);
+	texturesBytes += entry.bytes;
+}
+
+void GameCache::_accountSound(Entry<sf::SoundBuffer>& entry) {
+	entry.bytes = entry.asset.getSampleCount() * sizeof(sf::Int16);
+	soundsBytes += entry.bytes;
+}
+
+GameCache::Entry<sf::Texture>& GameCache::_getTexture(const std::string& textureName) {
 	// Check if image is already in cache
 	const auto nameSid = lif::sid(textureName);
 	auto it = textures.find(nameSid);
-	if (it != textures.end())
-		return &it->second;
+	if (it != textures.end()) {
+		++stats.hits;
+		it->second.lastUse = ++useClock;
+		return it->second;
+	}
+	++stats.misses;
+
+	// Check if it was requested already
+	const auto pending = std::find_if(pendingTextures.begin(), pendingTextures.end(),
+			[&textureName] (const std::unique_ptr<PendingTexture>& p) { return p->name == textureName; });
+	if (pending != pendingTextures.end()) {
+		auto& entry = _finishTexture(**pending);
+		pendingTextures.erase(pending);
+		return entry;
+	}
 
 	// Not in cache: load from file
-	auto& txt = textures[nameSid];
-	if (!txt.loadFromFile(textureName)) {
+	auto& entry = _addTexture(nameSid);
+	if (headless)
+		return entry;
+	if (!loadAsset(entry.asset, archive, textureName)) {
 		std::cerr << "[GameCache] Error: couldn't load texture " << textureName << " from file!\r\n";
 	}
 #ifndef RELEASE
@@ -28,34 +145,290 @@ sf::Texture* GameCache::loadTexture(const std::string& textureName) {
 		std::cerr << "[GameCache] Loaded " << textureName << std::endl;
 	}
 #endif
-	return &txt;
+	_accountTexture(entry);
+	return entry;
+}
+
+sf::Texture* GameCache::loadTexture(const std::string& textureName) {
+	auto& entry = _getTexture(textureName);
+	entry.pinned = true;
+	_enforceBudget();
+	return &entry.asset;
+}
+
+sf::Texture* GameCache::acquireTexture(const std::string& textureName) {
+	auto& entry = _getTexture(textureName);
+	++entry.refs;
+	_enforceBudget();
+	return &entry.asset;
+}
+
+void GameCache::releaseTexture(const sf::Texture *texture) {
+	const auto id = textureIds.find(texture);
+	if (id == textureIds.end())
+		return;
+	auto& entry = textures.find(id->second)->second;
+	if (entry.refs > 0)
+		--entry.refs;
+	entry.lastUse = ++useClock;
+}
+
+lif::AssetHandle<sf::Texture> GameCache::requestTexture(const std::string& textureName) {
+	lif::AssetHandle<sf::Texture> handle;
+
+	auto it = textures.find(lif::sid(textureName));
+	if (headless || it != textures.end()) {
+		auto& entry = it != textures.end() ? it->second : _getTexture(textureName);
+		entry.lastUse = ++useClock;
+		if (entry.handleState == nullptr) {
+			entry.handleState = std::make_shared<lif::AssetHandle<sf::Texture>::State>();
+			entry.handleState->asset = &entry.asset;
+		}
+		handle.state = entry.handleState;
+		return handle;
+	}
+	handle.state = std::make_shared<lif::AssetHandle<sf::Texture>::State>();
+
+	for (const auto& p : pendingTextures)
+		if (p->name == textureName)
+			return p->handle;
+
+	pendingTextures.emplace_back(new PendingTexture);
+	auto pending = pendingTextures.back().get();
+	pending->name = textureName;
+	pending->handle = handle;
+	const auto data = archive.find(textureName);
+	pending->done = _getLoaders().submit([pending, data] () {
+		pending->ok = data
+			? pending->image.loadFromMemory(data.data, data.size)
+			: pending->image.loadFromFile(pending->name);
+	});
+	return handle;
+}
+
+lif::AssetHandle<sf::SoundBuffer> GameCache::requestSound(const std::string& soundName) {
+	lif::AssetHandle<sf::SoundBuffer> handle;
+	handle.state = std::make_shared<lif::AssetHandle<sf::SoundBuffer>::State>();
+
+	if (headless) {
+		handle.state->failed = true;
+		return handle;
+	}
+	auto it = soundBuffers.find(lif::sid(soundName));
+	if (it != soundBuffers.end()) {
+		auto& entry = it->second;
+		entry.lastUse = ++useClock;
+		if (entry.handleState == nullptr) {
+			entry.handleState = handle.state;
+			entry.handleState->asset = &entry.asset;
+		}
+		handle.state = entry.handleState;
+		return handle;
+	}
+
+	for (const auto& p : pendingSounds)
+		if (p->name == soundName)
+			return p->handle;
+
+	pendingSounds.emplace_back(new PendingSound);
+	auto pending = pendingSounds.back().get();
+	pending->name = soundName;
+	pending->handle = handle;
+	const auto data = archive.find(soundName);
+	pending->done = _getLoaders().submit([pending, data] () {
+		sf::InputSoundFile file;
+		if (!(data ? file.openFromMemory(data.data, data.size) : file.openFromFile(pending->name)))
+			return;
+		pending->samples.resize(file.getSampleCount());
+		pending->channels = file.getChannelCount();
+		pending->sampleRate = file.getSampleRate();
+		pending->ok = file.read(pending->samples.data(), pending->samples.size()) == pending->samples.size();
+	});
+	return handle;
+}
+
+GameCache::Entry<sf::Texture>& GameCache::_finishTexture(PendingTexture& pending) {
+	pending.done.get();
+	const auto nameSid = lif::sid(pending.name);
+	auto it = textures.find(nameSid);
+	if (it != textures.end()) {
+		// Loaded synchronously in the meantime (e.g. by `buildAtlas`)
+		pending.handle.state->asset = &it->second.asset;
+		if (it->second.handleState == nullptr)
+			it->second.handleState = pending.handle.state;
+		return it->second;
+	}
+
+	auto& entry = _addTexture(nameSid);
+	entry.handleState = pending.handle.state;
+	if (!pending.ok || !entry.asset.loadFromImage(pending.image)) {
+		std::cerr << "[GameCache] Error: couldn't load texture " << pending.name << " from file!\r\n";
+		pending.handle.state->failed = true;
+	} else {
+#ifndef RELEASE
+		std::cerr << "[GameCache] Loaded " << pending.name << " (async)" << std::endl;
+#endif
+		pending.handle.state->asset = &entry.asset;
+		_accountTexture(entry);
+	}
+	return entry;
+}
+
+GameCache::Entry<sf::SoundBuffer>* GameCache::_finishSound(PendingSound& pending) {
+	pending.done.get();
+	const auto nameSid = lif::sid(pending.name);
+	auto it = soundBuffers.find(nameSid);
+	if (it != soundBuffers.end()) {
+		pending.handle.state->asset = &it->second.asset;
+		if (it->second.handleState == nullptr)
+			it->second.handleState = pending.handle.state;
+		return &it->second;
+	}
+
+	auto& entry = soundBuffers[nameSid];
+	if (!pending.ok || !entry.asset.loadFromSamples(pending.samples.data(), pending.samples.size(),
+				pending.channels, pending.sampleRate))
+	{
+		std::cerr << "[GameCache] Error: couldn't load sound " << pending.name << " from file!\r\n";
+		pending.handle.state->failed = true;
+		soundBuffers.erase(nameSid);
+		return nullptr;
+	}
+#ifndef RELEASE
+	std::cerr << "[GameCache] Loaded " << pending.name << " (async)" << std::endl;
+#endif
+	entry.lastUse = ++useClock;
+	entry.handleState = pending.handle.state;
+	pending.handle.state->asset = &entry.asset;
+	_accountSound(entry);
+	return &entry;
+}
+
+std::size_t GameCache::uploadPending(sf::Time budget) {
+	sf::Clock clock;
+	unsigned uploaded = 0;
+	const auto hasTime = [&] () { return uploaded == 0 || clock.getElapsedTime() < budget; };
+
+	for (auto it = pendingTextures.begin(); it != pendingTextures.end() && hasTime(); ) {
+		if (!isDone((*it)->done)) {
+			++it;
+			continue;
+		}
+		_finishTexture(**it);
+		it = pendingTextures.erase(it);
+		++uploaded;
+	}
+	for (auto it = pendingSounds.begin(); it != pendingSounds.end() && hasTime(); ) {
+		if (!isDone((*it)->done)) {
+			++it;
+			continue;
+		}
+		_finishSound(**it);
+		it = pendingSounds.erase(it);
+		++uploaded;
+	}
+	if (uploaded > 0)
+		_enforceBudget();
+
+	return pendingTextures.size() + pendingSounds.size();
+}
+
+void GameCache::_dropPending() {
+	for (auto& p : pendingTextures)
+		p->done.wait();
+	for (auto& p : pendingSounds)
+		p->done.wait();
+	pendingTextures.clear();
+	pendingSounds.clear();
+}
+
+void GameCache::buildAtlas(const std::vector<std::string>& textureNames) {
+	if (headless) return;
+
+	constexpr unsigned MAX_PAGE_SIZE = 4096;
+
+	std::vector<sf::Image> images(textureNames.size());
+	std::vector<lif::TextureAtlas::Entry> entries;
+	entries.reserve(textureNames.size());
+	for (unsigned i = 0; i < textureNames.size(); ++i) {
+		const auto& name = textureNames[i];
+		if (!loadAsset(images[i], archive, name)) {
+			std::cerr << "[GameCache] Error: couldn't load texture " << name << " from file!\r\n";
+			continue;
+		}
+		// Load the texture from the same image, unless it's already cached
+		const auto nameSid = lif::sid(name);
+		auto it = textures.find(nameSid);
+		auto entry = it != textures.end() ? &it->second : nullptr;
+		if (entry == nullptr) {
+			entry = &_addTexture(nameSid);
+			entry->asset.loadFromImage(images[i]);
+			_accountTexture(*entry);
+		}
+		// The atlas refers to the texture by its address, so it must never be evicted
+		entry->pinned = true;
+		entries.push_back({ &entry->asset, &images[i] });
+	}
+
+	atlas.build(entries, std::min(MAX_PAGE_SIZE, sf::Texture::getMaximumSize()));
+	if (mipmapping)
+		atlas.generateMipmaps();
+	atlasBytes = pagesBytes(atlas, mipmapping);
+	_enforceBudget();
+#ifndef RELEASE
+	std::cerr << "[GameCache] Packed " << entries.size() << " textures into "
+		<< atlas.getPagesCount() << " atlas page(s)" << std::endl;
+#endif
 }
 
 bool GameCache::loadSound(sf::Sound& sound, const std::string& soundName) {
+	if (headless) return false;
+
 	// Check if sound buffer is already in cache
 	const auto nameSid = lif::sid(soundName);
 	auto it = soundBuffers.find(nameSid);
 	if (it != soundBuffers.end()) {
-		sound.setBuffer(it->second);
+		++stats.hits;
+		it->second.lastUse = ++useClock;
+		sound.setBuffer(it->second.asset);
 		return true;
 	}
-	// Load from file and update the cache
-	auto& buf = soundBuffers[nameSid];
-	if (!buf.loadFromFile(soundName)) {
-		std::cerr << "[GameCache] Error: couldn't load sound " << soundName << " from file!\r\n";
-		return false;
-	}
+	++stats.misses;
+
+	// Check if it was requested already
+	const auto pending = std::find_if(pendingSounds.begin(), pendingSounds.end(),
+			[&soundName] (const std::unique_ptr<PendingSound>& p) { return p->name == soundName; });
+	Entry<sf::SoundBuffer> *entry = nullptr;
+	if (pending != pendingSounds.end()) {
+		entry = _finishSound(**pending);
+		pendingSounds.erase(pending);
+		if (entry == nullptr)
+			return false;
+	} else {
+		// Load from file and update the cache
+		entry = &soundBuffers[nameSid];
+		if (!loadAsset(entry->asset, archive, soundName)) {
+			std::cerr << "[GameCache] Error: couldn't load sound " << soundName << " from file!\r\n";
+			soundBuffers.erase(nameSid);
+			return false;
+		}
 #ifndef RELEASE
-	else {
 		std::cerr << "[GameCache] Loaded " << soundName << std::endl;
-	}
 #endif
-	sound.setBuffer(buf);
+		entry->lastUse = ++useClock;
+		_accountSound(*entry);
+	}
+	sound.setBuffer(entry->asset);
+	_enforceBudget();
 	return true;
 }
 
 void GameCache::playSound(const std::string& soundName) {
-	if (lif::options.soundsMute) return;
+#ifndef RELEASE
+	if (lif::JobSystem::inJob())
+		throw std::logic_error("Sounds must not be played by concurrent updates!");
+#endif
+	if (headless || lif::options.soundsMute) return;
 
 	// Find a free slot to put this sound into, or discard oldest sound
 	auto it = sounds.begin();
@@ -84,12 +457,15 @@ void GameCache::playSound(const std::string& soundName) {
 sf::Font* GameCache::loadFont(const std::string& fontName) {
 	const auto nameSid = lif::sid(fontName);
 	auto it = fonts.find(nameSid);
-	if (it != fonts.end())
+	if (it != fonts.end()) {
+		++stats.hits;
 		return &it->second;
+	}
+	++stats.misses;
 
 	// Load from file and update the cache
 	auto& font = fonts[nameSid];
-	if (!font.loadFromFile(fontName)) {
+	if (!loadAsset(font, archive, fontName)) {
 		std::cerr << "[GameCache.cpp] Error: couldn't load font " << fontName << " from file!\r\n";
 	}
 #ifndef RELEASE
@@ -100,9 +476,94 @@ sf::Font* GameCache::loadFont(const std::string& fontName) {
 	return &font;
 }
 
+void GameCache::_enforceBudget() {
+	const auto gpuOver = [this] () { return texturesBytes + atlasBytes > gpuBudget; };
+	const auto cpuOver = [this] () { return soundsBytes > cpuBudget; };
+	if (!gpuOver() && !cpuOver())
+		return;
+
+	const auto isPlaying = [this] (const sf::SoundBuffer& buf) {
+		return std::any_of(sounds.begin(), sounds.end(), [&buf] (const sf::Sound& s) {
+			return s.getBuffer() == &buf && s.getStatus() != sf::Sound::Status::Stopped;
+		});
+	};
+
+	struct Candidate {
+		std::uint64_t lastUse;
+		lif::StringId nameSid;
+		bool isTexture;
+	};
+	std::vector<Candidate> candidates;
+	if (gpuOver()) {
+		for (const auto& pair : textures) {
+			const auto& entry = pair.second;
+			if (!entry.pinned && entry.refs == 0 && entry.lastUse != useClock)
+				candidates.push_back({ entry.lastUse, pair.first, true });
+		}
+	}
+	if (cpuOver()) {
+		for (const auto& pair : soundBuffers) {
+			const auto& entry = pair.second;
+			if (entry.lastUse != useClock && !isPlaying(entry.asset))
+				candidates.push_back({ entry.lastUse, pair.first, false });
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), [] (const Candidate& a, const Candidate& b) {
+		return a.lastUse < b.lastUse;
+	});
+
+	for (const auto& c : candidates) {
+		if (c.isTexture && gpuOver())
+			_evictTexture(c.nameSid);
+		else if (!c.isTexture && cpuOver())
+			_evictSound(c.nameSid);
+	}
+}
+
+void GameCache::_evictTexture(lif::StringId nameSid) {
+	auto it = textures.find(nameSid);
+	auto& entry = it->second;
+	if (entry.handleState != nullptr)
+		entry.handleState->asset = nullptr;
+	texturesBytes -= entry.bytes;
+	textureIds.erase(&entry.asset);
+	textures.erase(it);
+	++stats.evictions;
+}
+
+void GameCache::_evictSound(lif::StringId nameSid) {
+	auto it = soundBuffers.find(nameSid);
+	auto& entry = it->second;
+	// Drop the stopped sounds still referring to this buffer
+	const auto buf = &entry.asset;
+	sounds.remove_if([buf] (const sf::Sound& s) { return s.getBuffer() == buf; });
+	if (entry.handleState != nullptr)
+		entry.handleState->asset = nullptr;
+	soundsBytes -= entry.bytes;
+	soundBuffers.erase(it);
+	++stats.evictions;
+}
+
+lif::CacheStats GameCache::getStats() const {
+	auto s = stats;
+	s.cpuBytes = soundsBytes;
+	s.gpuBytes = texturesBytes + atlasBytes;
+	s.textures = textures.size();
+	s.sounds = soundBuffers.size();
+	s.fonts = fonts.size();
+	return s;
+}
+
 void GameCache::finalize() {
+	_dropPending();
+	loaders.reset();
+	atlas.clear();
 	textures.clear();
+	textureIds.clear();
 	sounds.clear();
 	soundBuffers.clear();
 	fonts.clear();
+	// Fonts read their data lazily from the archive's memory, so close it last
+	archive.close();
+	texturesBytes = soundsBytes = atlasBytes = 0;
 }
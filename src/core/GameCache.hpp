@@ -1,28 +1,121 @@
 #pragma once
 
+#include "AssetArchive.hpp"
+#include "TextureAtlas.hpp"
+#include "ThreadPool.hpp"
 #include "sid.hpp"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <cstdint>
+#include <future>
 #include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace lif {
 
+class GameCache;
+
+/**
+ * A handle to an asset requested via GameCache::requestTexture or GameCache::requestSound.
+ * The asset is available once a worker thread decoded it and GameCache::uploadPending
+ * moved it into the cache (or once something loaded it synchronously in the meantime).
+ * Handles must only be used by the main thread.
+ */
+template<class T>
+class AssetHandle {
+	friend class lif::GameCache;
+
+	struct State {
+		T *asset = nullptr;
+		bool failed = false;
+	};
+	std::shared_ptr<State> state;
+
+public:
+	/** @return Whether the asset finished loading, either successfully or not */
+	bool isReady() const { return state != nullptr && (state->asset != nullptr || state->failed); }
+	/** @return Whether the asset couldn't be loaded */
+	bool hasFailed() const { return state != nullptr && state->failed; }
+	/** @return The loaded asset, or nullptr if it isn't ready yet, failed loading or
+	 *  was evicted from the cache since then.
+	 */
+	T* get() const { return state != nullptr ? state->asset : nullptr; }
+};
+
+/** Counters and memory estimates of a GameCache (see GameCache::getStats) */
+struct CacheStats {
+	/** Lookups which found the asset in the cache */
+	std::size_t hits = 0;
+	/** Lookups which had to load the asset */
+	std::size_t misses = 0;
+	/** Assets dropped to stay within the memory budget */
+	std::size_t evictions = 0;
+	/** Estimated bytes of sound samples held in RAM */
+	std::size_t cpuBytes = 0;
+	/** Estimated bytes of textures held in video memory, atlas pages included */
+	std::size_t gpuBytes = 0;
+	std::size_t textures = 0;
+	std::size_t sounds = 0;
+	std::size_t fonts = 0;
+};
+
 /**
  * Keeps the loaded textures and sounds in memory for faster loading;
- * works as an associative set name => pointer-to-resource
+ * works as an associative set name => pointer-to-resource.
+ * When the estimated memory used by textures or sounds exceeds its budget, the least
+ * recently used ones which are not in use are evicted (see `setMemoryBudget`).
  */
 class GameCache final : private sf::NonCopyable {
 	std::size_t maxParallelSounds = 10;
 
+	/** If true, textures and sounds are never decoded nor played (see `setHeadless`) */
+	bool headless = false;
+
+	/** A cached texture or sound buffer along with its bookkeeping */
+	template<class T>
+	struct Entry {
+		T asset;
+		/** How many holders acquired this asset (see `acquireTexture`) */
+		unsigned refs = 0;
+		/** Pinned assets are never evicted, as their holders are not tracked */
+		bool pinned = false;
+		/** Value of `useClock` when this asset was last used */
+		std::uint64_t lastUse = 0;
+		std::size_t bytes = 0;
+		/** The state of the handle given by the request which loaded this asset, if any */
+		std::shared_ptr<typename lif::AssetHandle<T>::State> handleState;
+	};
+
 	/** The game textures */
-	std::unordered_map<lif::StringId, sf::Texture> textures;
+	std::unordered_map<lif::StringId, Entry<sf::Texture>> textures;
+	/** Maps each cached texture back to its key, for `releaseTexture` */
+	std::unordered_map<const sf::Texture*, lif::StringId> textureIds;
 
 	/** The sound buffers used by sounds */
-	std::unordered_map<lif::StringId, sf::SoundBuffer> soundBuffers;
+	std::unordered_map<lif::StringId, Entry<sf::SoundBuffer>> soundBuffers;
+
+	/** Whether the textures get mipmaps (see `setMipmapping`) */
+	bool mipmapping = false;
+
+	/** Incremented at each use of a texture or sound, to order them by recency */
+	std::uint64_t useClock = 0;
+	std::size_t cpuBudget;
+	std::size_t gpuBudget;
+	/** Estimated bytes of the cached sound buffers, textures and atlas pages */
+	std::size_t soundsBytes = 0;
+	std::size_t texturesBytes = 0;
+	std::size_t atlasBytes = 0;
+	lif::CacheStats stats;
+
+	/** If open, assets packed in it are loaded from there rather than from their own file */
+	lif::AssetArchive archive;
+
+	/** Where the textures given to `buildAtlas` were packed */
+	lif::TextureAtlas atlas;
 
 	/** The game fonts */
 	std::unordered_map<lif::StringId, sf::Font> fonts;
@@ -33,20 +126,138 @@ class GameCache final : private sf::NonCopyable {
 	 */
 	std::list<sf::Sound> sounds;
 
+	/** A texture being decoded by a worker thread */
+	struct PendingTexture {
+		std::string name;
+		/** Written by the worker; only read after `done` is ready */
+		sf::Image image;
+		bool ok = false;
+		std::future<void> done;
+		lif::AssetHandle<sf::Texture> handle;
+	};
+	/** A sound being decoded by a worker thread */
+	struct PendingSound {
+		std::string name;
+		/** Written by the worker; only read after `done` is ready */
+		std::vector<sf::Int16> samples;
+		unsigned channels = 0;
+		unsigned sampleRate = 0;
+		bool ok = false;
+		std::future<void> done;
+		lif::AssetHandle<sf::SoundBuffer> handle;
+	};
+
+	/** The worker threads decoding the requested assets, started by the first request */
+	std::unique_ptr<lif::ThreadPool> loaders;
+	/** The requests not uploaded yet, in FIFO order */
+	std::vector<std::unique_ptr<PendingTexture>> pendingTextures;
+	std::vector<std::unique_ptr<PendingSound>> pendingSounds;
+
+	lif::ThreadPool& _getLoaders();
+	/** Waits for `pending` to be decoded and puts the decoded asset into the cache.
+	 *  `_finishSound` returns nullptr if the sound couldn't be loaded.
+	 */
+	Entry<sf::Texture>& _finishTexture(PendingTexture& pending);
+	Entry<sf::SoundBuffer>* _finishSound(PendingSound& pending);
+	/** Waits for all the pending requests and discards them */
+	void _dropPending();
+	/** Looks `textureName` up, loading it if needed, and marks it as used */
+	Entry<sf::Texture>& _getTexture(const std::string& textureName);
+	/** Inserts a new, empty texture entry keyed `nameSid` */
+	Entry<sf::Texture>& _addTexture(lif::StringId nameSid);
+	/** Generates the mipmaps of the texture just loaded into `entry`, if needed, and adds
+	 *  its size to the memory estimates.
+	 */
+	void _accountTexture(Entry<sf::Texture>& entry);
+	void _accountSound(Entry<sf::SoundBuffer>& entry);
+	/** Evicts the least recently used assets which are not in use until both the CPU and
+	 *  GPU estimates are within their budget, or nothing else can be evicted.
+	 *  The asset used last is never evicted, as its user may not have taken it yet.
+	 */
+	void _enforceBudget();
+	void _evictTexture(lif::StringId nameSid);
+	void _evictSound(lif::StringId nameSid);
+
 public:
 	explicit GameCache();
 
 	void setMaxParallelSounds(std::size_t n);
 
+	/** In headless mode, `loadTexture` returns empty textures and `loadSound` never loads
+	 *  any buffer, so the game can run without a graphics or audio device.
+	 */
+	void setHeadless(bool b) { headless = b; }
+	bool isHeadless() const { return headless; }
+
+	/** Opens the asset archive `path` (see lif::AssetArchive), whose entries are relative to
+	 *  `rootDir`. From then on, the assets found in the archive are loaded from memory rather
+	 *  than opening their own file. Should be called before loading any asset.
+	 *  @return Whether the archive could be opened
+	 */
+	bool openArchive(const std::string& path, const std::string& rootDir);
+	const lif::AssetArchive& getArchive() const { return archive; }
+
+	/** If true, all textures (current and future, atlas pages included) get mipmaps, so that they
+	 *  are sampled from a matching downscaled copy when drawn smaller than their size.
+	 *  Meant for when the game is rendered below its designed resolution (see lif::getRenderDownscale).
+	 *  Mipmaps make a texture take 1/3 more memory and are kept if this is set back to false.
+	 */
+	void setMipmapping(bool b);
+	bool isMipmapping() const { return mipmapping; }
+
+	/** Sets how many bytes the sound samples (`cpuBytes`) and the textures (`gpuBytes`, an
+	 *  estimate of the video memory used) may take before unused assets are evicted.
+	 *  The budgets are soft: assets in use are never evicted.
+	 */
+	void setMemoryBudget(std::size_t cpuBytes, std::size_t gpuBytes);
+
 	/** If the texture loaded from `texture_name` already exists in the cache,
 	 *  return its pointer; else try to load it from `texture_name` and return either
 	 *  a pointer to it, or nullptr if the loading failed.
+	 *  The returned texture is pinned: it's never evicted.
 	 */
 	sf::Texture* loadTexture(const std::string& textureName);
 
+	/** Like `loadTexture`, but rather than pinning the texture it counts a reference to it,
+	 *  which must be dropped with `releaseTexture` when the texture isn't needed anymore.
+	 *  Textures with no references left may be evicted.
+	 */
+	sf::Texture* acquireTexture(const std::string& textureName);
+	/** Drops a reference taken by `acquireTexture`. Does nothing if `texture` isn't cached. */
+	void releaseTexture(const sf::Texture *texture);
+
+	/** Starts loading the texture `textureName` in background, unless it's already cached.
+	 *  The image is decoded by a worker thread, while the texture is created by a later
+	 *  `uploadPending` (or by `loadTexture`, which waits for the decoding if needed).
+	 *  In headless mode this is the same as `loadTexture`.
+	 */
+	lif::AssetHandle<sf::Texture> requestTexture(const std::string& textureName);
+
+	/** Starts loading the sound `soundName` in background, unless it's already cached.
+	 *  See `requestTexture`. In headless mode the returned handle is always failed.
+	 */
+	lif::AssetHandle<sf::SoundBuffer> requestSound(const std::string& soundName);
+
+	/** Puts the assets decoded so far by the worker threads into the cache, stopping as soon
+	 *  as `budget` is exceeded (after at least one asset). Must be called by the main thread,
+	 *  typically once per frame.
+	 *  @return The number of assets still pending
+	 */
+	std::size_t uploadPending(sf::Time budget);
+
+	/** Packs the textures loaded from `textureNames` (loading them if not cached yet) into the
+	 *  texture atlas, so that sprites using any of them can be drawn in a single batch.
+	 *  Does nothing in headless mode.
+	 */
+	void buildAtlas(const std::vector<std::string>& textureNames);
+
+	const lif::TextureAtlas& getAtlas() const { return atlas; }
+
 	/** Tries to load `sound_name` into `sound`; if `sound_name` is already
 	 *  in the cache, load it from there; else, load from file and put the
 	 *  loaded soundbuffer into the cache.
+	 *  The buffer may be evicted once `sound` stopped playing, so `sound` must not
+	 *  be kept around to be replayed later.
 	 */
 	bool loadSound(sf::Sound& sound, const std::string& soundName);
 
@@ -66,6 +277,9 @@ public:
 	 */
 	sf::Font* loadFont(const std::string& fontName);
 
+	/** @return The cache counters and the current memory estimates */
+	lif::CacheStats getStats() const;
+
 	/** If the GameCache is a global object, this method must be called
 	 *  before exiting the program to prevent crashes due to improper
 	 *  automatic cleanup.
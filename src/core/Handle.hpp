@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace lif {
+
+/**
+ * A weak, non-owning reference to an object registered in a SlotTable.
+ * Unlike a std::weak_ptr, checking whether a Handle is still valid is a plain index load
+ * and comparison, with no reference counting involved.
+ * A default-constructed Handle is never valid.
+ */
+template<typename T>
+struct Handle {
+	std::uint32_t index = 0;
+	/** Generation 0 is never used by a live slot */
+	std::uint32_t generation = 0;
+
+	bool isNull() const { return generation == 0; }
+
+	bool operator==(const Handle& other) const {
+		return index == other.index && generation == other.generation;
+	}
+	bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+/**
+ * A table of unowned objects addressed by generational Handles.
+ * Releasing a slot bumps its generation, so all the Handles previously pointing to it
+ * become invalid; the slot is then reused by later insertions.
+ */
+template<typename T>
+class SlotTable final {
+	struct Slot {
+		T *ptr = nullptr;
+		std::uint32_t generation = 1;
+	};
+
+	std::vector<Slot> slots;
+	std::vector<std::uint32_t> freeSlots;
+
+public:
+	/** Registers `obj` and returns a Handle to it */
+	Handle<T> insert(T *obj) {
+		std::uint32_t idx;
+		if (freeSlots.size() > 0) {
+			idx = freeSlots.back();
+			freeSlots.pop_back();
+		} else {
+			idx = slots.size();
+			slots.emplace_back();
+		}
+		slots[idx].ptr = obj;
+		return Handle<T> { idx, slots[idx].generation };
+	}
+
+	/** Invalidates `handle`. Does nothing if it's already invalid. */
+	void release(Handle<T> handle) {
+		if (get(handle) == nullptr)
+			return;
+		auto& slot = slots[handle.index];
+		slot.ptr = nullptr;
+		// Skip generation 0 on wraparound, as that's the null Handle's one
+		if (++slot.generation == 0)
+			slot.generation = 1;
+		freeSlots.emplace_back(handle.index);
+	}
+
+	/** Invalidates all handles */
+	void clear() {
+		for (auto& slot : slots) {
+			if (slot.ptr == nullptr) continue;
+			slot.ptr = nullptr;
+			if (++slot.generation == 0)
+				slot.generation = 1;
+		}
+		freeSlots.clear();
+		for (std::uint32_t i = slots.size(); i > 0; --i)
+			freeSlots.emplace_back(i - 1);
+	}
+
+	/** @return The object referenced by `handle`, or nullptr if it's not valid anymore */
+	T* get(Handle<T> handle) const {
+		if (handle.index >= slots.size())
+			return nullptr;
+		const auto& slot = slots[handle.index];
+		return slot.generation == handle.generation ? slot.ptr : nullptr;
+	}
+
+	/** @return The number of live objects */
+	std::size_t size() const { return slots.size() - freeSlots.size(); }
+};
+
+}
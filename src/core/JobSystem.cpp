@@ -0,0 +1,117 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+#ifndef RELEASE
+#	include "Tracer.hpp"
+#endif
+
+using lif::JobSystem;
+
+static thread_local bool runningJob = false;
+
+JobSystem::JobSystem(unsigned nThreads)
+	: nextItem(0)
+{
+	if (nThreads == 0)
+		nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	workers.reserve(nThreads - 1);
+	for (unsigned i = 1; i < nThreads; ++i)
+		workers.emplace_back([this] () { _work(); });
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stopping = true;
+	}
+	startCv.notify_all();
+	for (auto& w : workers)
+		w.join();
+}
+
+bool JobSystem::inJob() {
+	return runningJob;
+}
+
+void JobSystem::parallelFor(std::size_t n, std::size_t grain, const Job& func) {
+	grain = std::max(grain, std::size_t(1));
+	if (workers.empty() || n <= grain) {
+		runningJob = true;
+		try {
+			for (std::size_t begin = 0; begin < n; begin += grain)
+				func(begin, std::min(begin + grain, n));
+		} catch (...) {
+			runningJob = false;
+			throw;
+		}
+		runningJob = false;
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		job = &func;
+		jobSize = n;
+		this->grain = grain;
+		nextItem.store(0, std::memory_order_relaxed);
+		error = nullptr;
+		busyWorkers = workers.size();
+		++generation;
+	}
+	startCv.notify_all();
+
+	_runChunks();
+
+	std::exception_ptr jobError;
+	{
+		// `func` must outlive all the workers' chunks
+		std::unique_lock<std::mutex> lock(mtx);
+		doneCv.wait(lock, [this] () { return busyWorkers == 0; });
+		job = nullptr;
+		std::swap(jobError, error);
+	}
+	if (jobError)
+		std::rethrow_exception(jobError);
+}
+
+void JobSystem::_runChunks() {
+	runningJob = true;
+	while (true) {
+		const auto begin = nextItem.fetch_add(grain, std::memory_order_relaxed);
+		if (begin >= jobSize)
+			break;
+		try {
+			(*job)(begin, std::min(begin + grain, jobSize));
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(mtx);
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+	runningJob = false;
+}
+
+void JobSystem::_work() {
+	std::uint64_t lastGeneration = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			startCv.wait(lock, [this, lastGeneration] () {
+				return stopping || generation != lastGeneration;
+			});
+			if (stopping)
+				return;
+			lastGeneration = generation;
+		}
+		{
+#ifndef RELEASE
+			LIF_TRACE_ZONE("job");
+#endif
+			_runChunks();
+		}
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			if (--busyWorkers == 0)
+				doneCv.notify_one();
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SFML/System/NonCopyable.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lif {
+
+/**
+ * A fixed set of worker threads running data-parallel loops (see parallelFor) together with
+ * the calling thread. Unlike ThreadPool, which queues independent tasks, this is meant for
+ * short fork-join jobs run every frame: the loop is split into chunks which each thread claims
+ * as soon as it's done with the previous one, so the threads which finish early take over
+ * the remaining work.
+ * Only one job can run at a time, and parallelFor must not be called from inside a job.
+ * The JobSystem must be destroyed by the thread which created it.
+ */
+class JobSystem final : private sf::NonCopyable {
+public:
+	/** Processes the items in [begin, end) */
+	using Job = std::function<void(std::size_t begin, std::size_t end)>;
+
+private:
+	std::vector<std::thread> workers;
+	std::mutex mtx;
+	std::condition_variable startCv, doneCv;
+	bool stopping = false;
+
+	// The current job
+	const Job *job = nullptr;
+	std::size_t jobSize = 0;
+	std::size_t grain = 1;
+	/** The first item not claimed yet */
+	std::atomic<std::size_t> nextItem;
+	/** Incremented on each new job, so that the workers can tell it from the previous one */
+	std::uint64_t generation = 0;
+	/** How many workers are still working on the current job */
+	unsigned busyWorkers = 0;
+	/** The first exception thrown by the current job, rethrown by parallelFor */
+	std::exception_ptr error;
+
+	void _work();
+	/** Runs chunks of the current job until there are none left */
+	void _runChunks();
+
+public:
+	/** Creates a JobSystem using `nThreads` threads in total (including the one calling parallelFor).
+	 *  If `nThreads` is 0, it uses the number of hardware threads; if it's 1, jobs are run inline.
+	 */
+	explicit JobSystem(unsigned nThreads);
+	~JobSystem();
+
+	/** Calls `func` on consecutive ranges of at most `grain` items, covering [0, n), using all
+	 *  threads, and returns when all of them are done. If `func` throws, the first exception is
+	 *  rethrown here (after the other ranges are done).
+	 */
+	void parallelFor(std::size_t n, std::size_t grain, const Job& func);
+
+	/** @return The number of threads running the jobs, including the calling one */
+	unsigned getThreadsCount() const { return workers.size() + 1; }
+
+	/** @return Whether the calling thread is running a job. Used to catch code running in a
+	 *  job which should not (e.g. spawning entities).
+	 */
+	static bool inJob();
+};
+
+}
@@ -12,6 +12,14 @@ struct Options {
 
 	bool vsync = true;
 	int framerateLimit = 60;
+	/** How many times per second the simulation is stepped, independently of the framerate.
+	 *  If 0, the simulation is stepped once per frame.
+	 */
+	int simulationRate = 120;
+	/** How many threads update the entities (see EntityGroup::updateAll). If 0, as many as
+	 *  the hardware threads. Only read when a level manager is created.
+	 */
+	unsigned updateThreads = 0;
 
 	/** This is the designed size of the application. Used, for example, to correctly
 	 *  resize the content when window is resized. Must be set manually.
@@ -31,6 +39,8 @@ struct Options {
 #ifndef RELEASE
 	/** If true, print to console time stats for the drawing phase */
 	bool printDrawStats = false;
+	/** If true, print to console the GameCache stats */
+	bool printCacheStats = false;
 #endif
 
 };
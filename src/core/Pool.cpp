@@ -0,0 +1,72 @@
+#include "Pool.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using lif::FreeListPool;
+
+/** Size classes are multiples of this */
+constexpr std::size_t GRANULARITY = 16;
+constexpr std::size_t N_SIZE_CLASSES = lif::pool::MAX_POOLED_SIZE / GRANULARITY;
+
+/** All the pools ever created, for the stats (never destroyed, like the pools themselves) */
+static std::vector<FreeListPool*>& allPools() {
+	static auto pools = new std::vector<FreeListPool*>;
+	return *pools;
+}
+
+FreeListPool::FreeListPool(std::size_t blockSize, bool typed)
+	: blockSize(std::max(blockSize, sizeof(Node)))
+	, typed(typed)
+{
+	allPools().emplace_back(this);
+}
+
+void* FreeListPool::allocate() {
+	++stats.inUse;
+	if (head != nullptr) {
+		auto node = head;
+		head = head->next;
+		++stats.reused;
+		return node;
+	}
+	++stats.fresh;
+	return ::operator new(blockSize);
+}
+
+void FreeListPool::deallocate(void *ptr) {
+	if (ptr == nullptr) return;
+	--stats.inUse;
+	auto node = static_cast<Node*>(ptr);
+	node->next = head;
+	head = node;
+}
+
+static FreeListPool& sizeClass(std::size_t size) {
+	static std::array<FreeListPool*, N_SIZE_CLASSES> classes {};
+	const auto idx = (std::max(size, std::size_t(1)) - 1) / GRANULARITY;
+	if (classes[idx] == nullptr)
+		classes[idx] = new FreeListPool((idx + 1) * GRANULARITY);
+	return *classes[idx];
+}
+
+void* lif::pool::allocate(std::size_t size) {
+	if (size > MAX_POOLED_SIZE)
+		return ::operator new(size);
+	return sizeClass(size).allocate();
+}
+
+void lif::pool::deallocate(void *ptr, std::size_t size) {
+	if (size > MAX_POOLED_SIZE)
+		::operator delete(ptr);
+	else
+		sizeClass(size).deallocate(ptr);
+}
+
+lif::PoolStats lif::pool::getStats(bool typed) {
+	lif::PoolStats stats;
+	for (auto pool : allPools())
+		if (pool->isTyped() == typed)
+			stats += pool->getStats();
+	return stats;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <new>
+
+namespace lif {
+
+/** Allocation counters of a memory pool */
+struct PoolStats {
+	/** Blocks which had to be taken from the heap */
+	std::size_t fresh = 0;
+	/** Blocks which were recycled from previously freed ones */
+	std::size_t reused = 0;
+	/** Blocks currently handed out */
+	std::size_t inUse = 0;
+
+	PoolStats& operator+=(const PoolStats& other) {
+		fresh += other.fresh;
+		reused += other.reused;
+		inUse += other.inUse;
+		return *this;
+	}
+};
+
+/**
+ * A free list of fixed-size memory blocks. Freed blocks are kept for later reuse rather than
+ * being given back to the heap, so after the first few occurrences of a workload no more heap
+ * allocations are needed for it.
+ * Pools are never destroyed, as pooled objects may outlive any static object; they are not
+ * thread-safe either.
+ */
+class FreeListPool final : private sf::NonCopyable {
+	struct Node {
+		Node *next;
+	};
+
+	const std::size_t blockSize;
+	/** Whether this is the pool of a single type (see lif::Pooled), or a size class */
+	const bool typed;
+	Node *head = nullptr;
+	PoolStats stats;
+
+public:
+	explicit FreeListPool(std::size_t blockSize, bool typed = false);
+
+	void* allocate();
+	void deallocate(void *ptr);
+
+	std::size_t getBlockSize() const { return blockSize; }
+	bool isTyped() const { return typed; }
+	const PoolStats& getStats() const { return stats; }
+};
+
+namespace pool {
+
+/** Requests larger than this are not pooled */
+constexpr std::size_t MAX_POOLED_SIZE = 1024;
+
+/** Allocates `size` bytes from the pool of the smallest size class fitting them
+ *  (or from the heap, if `size > MAX_POOLED_SIZE`).
+ */
+void* allocate(std::size_t size);
+/** Gives back memory obtained by `allocate(size)`. */
+void deallocate(void *ptr, std::size_t size);
+
+/** @return The summed counters of all the typed pools (if `typed`) or of all the size classes */
+lif::PoolStats getStats(bool typed);
+
+} // end namespace pool
+
+/** A standard allocator taking its memory from the lif::pool size classes.
+ *  Used to pool components and shared_ptr control blocks (see `std::allocate_shared`).
+ */
+template<class T>
+struct PoolAllocator {
+	using value_type = T;
+
+	PoolAllocator() = default;
+	template<class U>
+	PoolAllocator(const PoolAllocator<U>&) {}
+
+	T* allocate(std::size_t n) {
+		return static_cast<T*>(lif::pool::allocate(n * sizeof(T)));
+	}
+	void deallocate(T *ptr, std::size_t n) {
+		lif::pool::deallocate(ptr, n * sizeof(T));
+	}
+
+	template<class U>
+	bool operator==(const PoolAllocator<U>&) const { return true; }
+	template<class U>
+	bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+/**
+ * Inheriting from Pooled<T> makes `new T` and `delete` take T's memory from a free list
+ * dedicated to T, so short-lived entities which are continuously spawned and destroyed
+ * (bullets, explosions, ...) recycle their storage.
+ * Subclasses of T with a different size are allocated on the heap as usual.
+ */
+template<class T>
+class Pooled {
+	static lif::FreeListPool& _pool() {
+		static auto pool = new lif::FreeListPool(sizeof(T), true);
+		return *pool;
+	}
+
+public:
+	static void* operator new(std::size_t size) {
+		return size == sizeof(T) ? _pool().allocate() : ::operator new(size);
+	}
+
+	static void operator delete(void *ptr, std::size_t size) {
+		if (size == sizeof(T))
+			_pool().deallocate(ptr);
+		else
+			::operator delete(ptr);
+	}
+};
+
+}
@@ -0,0 +1,15 @@
+#include "Random.hpp"
+#include <atomic>
+
+/** The seed of the next stream. Consecutive streams get consecutive seeds, which
+ *  Random's constructor scrambles into unrelated states.
+ */
+static std::atomic<std::uint64_t> nextStreamSeed(0);
+
+void lif::seedRandomStreams(std::uint64_t seed) {
+	nextStreamSeed.store(seed, std::memory_order_relaxed);
+}
+
+lif::Random lif::newRandomStream() {
+	return lif::Random(nextStreamSeed.fetch_add(1, std::memory_order_relaxed));
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace lif {
+
+/**
+ * A small and fast pseudo-random number generator (xoshiro128**), meant to give each
+ * Entity its own stream of random numbers (see Entity::getRandom), so that the entities'
+ * random choices don't depend on the order in which they are updated.
+ * It satisfies UniformRandomBitGenerator, so it can also be used with the <random>
+ * distributions and with std::shuffle.
+ */
+class Random final {
+	std::uint32_t s[4];
+
+	static std::uint32_t rotl(std::uint32_t x, int k) {
+		return (x << k) | (x >> (32 - k));
+	}
+
+public:
+	using result_type = std::uint32_t;
+
+	/** Seeds the generator from `seed`, which may be any value (including 0). */
+	explicit Random(std::uint64_t seed = 0) {
+		// Expand the seed with splitmix64, as recommended by xoshiro's authors
+		for (int i = 0; i < 4; i += 2) {
+			std::uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			z ^= z >> 31;
+			s[i] = static_cast<std::uint32_t>(z);
+			s[i + 1] = static_cast<std::uint32_t>(z >> 32);
+		}
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	result_type operator()() {
+		const auto result = rotl(s[1] * 5, 7) * 9;
+		const auto t = s[1] << 9;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 11);
+		return result;
+	}
+
+	/** @return An uniformly distributed integer in [lo, hi] (`lo` must not be greater than `hi`) */
+	int nextInt(int lo, int hi) {
+		// Lemire's multiply-and-reject: no division in the common case
+		const auto range = static_cast<std::uint32_t>(hi) - static_cast<std::uint32_t>(lo) + 1;
+		if (range == 0)
+			return static_cast<int>((*this)());
+		std::uint64_t m = std::uint64_t((*this)()) * range;
+		auto low = static_cast<std::uint32_t>(m);
+		if (low < range) {
+			const auto threshold = (0u - range) % range;
+			while (low < threshold) {
+				m = std::uint64_t((*this)()) * range;
+				low = static_cast<std::uint32_t>(m);
+			}
+		}
+		return static_cast<int>(static_cast<std::uint32_t>(lo) + static_cast<std::uint32_t>(m >> 32));
+	}
+
+	/** @return An uniformly distributed float in [lo, hi) */
+	float nextFloat(float lo, float hi) {
+		// The top 24 bits fill exactly a float's mantissa
+		return lo + (hi - lo) * (((*this)() >> 8) * (1.f / 16777216.f));
+	}
+};
+
+/** Reseeds the streams returned by newRandomStream() from `seed`. Called on each level start with
+ *  a value drawn from lif::rng, so that the same seed gives the same streams in the same order.
+ */
+void seedRandomStreams(std::uint64_t seed);
+
+/** @return A new Random, seeded from the next value of the sequence started by seedRandomStreams */
+lif::Random newRandomStream();
+
+}
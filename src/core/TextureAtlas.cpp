@@ -0,0 +1,77 @@
+#include "TextureAtlas.hpp"
+#include <algorithm>
+#include <numeric>
+
+using lif::TextureAtlas;
+
+void TextureAtlas::build(const std::vector<TextureAtlas::Entry>& entries, unsigned pageSize) {
+	clear();
+
+	// Shelf packing: place the textures by decreasing height, left to right, opening a new
+	// shelf when the current one is full and a new page when the current page is full.
+	std::vector<std::size_t> order(entries.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&entries] (auto a, auto b) {
+		return entries[a].image->getSize().y > entries[b].image->getSize().y;
+	});
+
+	struct Placement {
+		std::size_t entry;
+		unsigned page;
+		sf::Vector2u pos;
+	};
+	std::vector<Placement> placements;
+	placements.reserve(entries.size());
+	// The used size of each page
+	std::vector<sf::Vector2u> pageSizes;
+
+	unsigned x = 0, y = 0, shelfHeight = 0;
+	for (auto i : order) {
+		const auto size = entries[i].image->getSize();
+		if (size.x == 0 || size.y == 0 || size.x > pageSize || size.y > pageSize)
+			continue;
+
+		if (pageSizes.size() == 0) {
+			pageSizes.emplace_back(0, 0);
+		} else if (x + size.x > pageSize) {
+			// New shelf
+			x = 0;
+			y += shelfHeight + PADDING;
+			shelfHeight = 0;
+		}
+		if (y + size.y > pageSize) {
+			// New page
+			pageSizes.emplace_back(0, 0);
+			x = y = shelfHeight = 0;
+		}
+		const unsigned page = pageSizes.size() - 1;
+		placements.push_back({ i, page, sf::Vector2u(x, y) });
+		pageSizes[page].x = std::max(pageSizes[page].x, x + size.x);
+		pageSizes[page].y = std::max(pageSizes[page].y, y + size.y);
+		x += size.x + PADDING;
+		shelfHeight = std::max(shelfHeight, size.y);
+	}
+
+	// Blit the textures into their pages
+	std::vector<sf::Image> pageImages(pageSizes.size());
+	for (unsigned i = 0; i < pageSizes.size(); ++i)
+		pageImages[i].create(pageSizes[i].x, pageSizes[i].y, sf::Color::Transparent);
+	for (const auto& p : placements) {
+		pageImages[p.page].copy(*entries[p.entry].image, p.pos.x, p.pos.y);
+		regions[entries[p.entry].texture] = Region { p.page, sf::Vector2f(p.pos) };
+	}
+	for (const auto& img : pageImages) {
+		pages.emplace_back(new sf::Texture);
+		pages.back()->loadFromImage(img);
+	}
+}
+
+void TextureAtlas::generateMipmaps() {
+	for (auto& page : pages)
+		page->generateMipmap();
+}
+
+void TextureAtlas::clear() {
+	pages.clear();
+	regions.clear();
+}
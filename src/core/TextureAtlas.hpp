@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace lif {
+
+/**
+ * A few large textures ("pages") in which many small textures are packed, so that sprites using
+ * any of the packed textures can be drawn together in a single draw call (see lif::Batchable).
+ * The packed textures keep existing on their own: the atlas only maps each of them to its
+ * copy in a page.
+ */
+class TextureAtlas final : private sf::NonCopyable {
+public:
+	/** Where a packed texture was put */
+	struct Region {
+		unsigned page;
+		/** Position of the texture's top-left corner in its page */
+		sf::Vector2f offset;
+	};
+
+	/** A texture to pack along with its pixels */
+	struct Entry {
+		const sf::Texture *texture;
+		const sf::Image *image;
+	};
+
+private:
+	/** Pixels left between packed textures, so that they don't bleed into each other
+	 *  (also in the first mipmap levels, see `generateMipmaps`).
+	 */
+	static constexpr unsigned PADDING = 4;
+
+	std::vector<std::unique_ptr<sf::Texture>> pages;
+	std::unordered_map<const sf::Texture*, Region> regions;
+
+public:
+	/** Discards the current pages and packs `entries` into new ones, of at most `pageSize`x`pageSize`
+	 *  pixels. Textures larger than a page are skipped.
+	 */
+	void build(const std::vector<Entry>& entries, unsigned pageSize);
+	void clear();
+	/** Generates the mipmaps of all the pages */
+	void generateMipmaps();
+
+	/** @return The region where `texture` was packed, or nullptr if it's not in this atlas */
+	const Region* find(const sf::Texture *texture) const {
+		const auto it = regions.find(texture);
+		return it == regions.end() ? nullptr : &it->second;
+	}
+
+	std::size_t getPagesCount() const { return pages.size(); }
+	const sf::Texture& getPage(unsigned page) const { return *pages[page]; }
+};
+
+}
@@ -0,0 +1,54 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#ifndef RELEASE
+#	include "Tracer.hpp"
+#endif
+
+using lif::ThreadPool;
+
+ThreadPool::ThreadPool(unsigned nThreads) {
+	nThreads = std::max(nThreads, 1u);
+	workers.reserve(nThreads);
+	for (unsigned i = 0; i < nThreads; ++i)
+		workers.emplace_back([this] () { _work(); });
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		stopping = true;
+	}
+	cv.notify_all();
+	for (auto& w : workers)
+		w.join();
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+	std::packaged_task<void()> pt(std::move(task));
+	auto future = pt.get_future();
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		tasks.emplace_back(std::move(pt));
+	}
+	cv.notify_one();
+	return future;
+}
+
+void ThreadPool::_work() {
+	while (true) {
+		std::packaged_task<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			cv.wait(lock, [this] () { return stopping || !tasks.empty(); });
+			// Drain the queue before quitting
+			if (tasks.empty())
+				return;
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+#ifndef RELEASE
+		LIF_TRACE_ZONE("pool_task");
+#endif
+		task();
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/System/NonCopyable.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lif {
+
+/**
+ * A fixed set of worker threads running the tasks submitted to it in FIFO order.
+ * The pool must be destroyed by the thread which created it; destroying it waits
+ * for the queued tasks to be run.
+ */
+class ThreadPool final : private sf::NonCopyable {
+	std::vector<std::thread> workers;
+	std::deque<std::packaged_task<void()>> tasks;
+	std::mutex mtx;
+	std::condition_variable cv;
+	bool stopping = false;
+
+	void _work();
+
+public:
+	/** Starts `nThreads` workers (at least one) */
+	explicit ThreadPool(unsigned nThreads);
+	~ThreadPool();
+
+	/** Queues `task` to be run by any worker.
+	 *  @return A future becoming ready when `task` is done (and rethrowing anything it threw).
+	 */
+	std::future<void> submit(std::function<void()> task);
+
+	unsigned getThreadsCount() const { return workers.size(); }
+};
+
+}
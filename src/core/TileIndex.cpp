@@ -0,0 +1,60 @@
+#include "TileIndex.hpp"
+#include "Entity.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <limits>
+
+using lif::TileIndex;
+
+void TileIndex::rebuild(const std::vector<std::shared_ptr<lif::Entity>>& entities) {
+	if (entities.size() == 0) {
+		clear();
+		return;
+	}
+
+	// Find the bounds of the indexed area
+	sf::Vector2i mn(std::numeric_limits<int>::max(), std::numeric_limits<int>::max()),
+	             mx(std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
+	for (const auto& e : entities) {
+		const auto t = lif::tile2(e->getPosition());
+		mn.x = std::min(mn.x, t.x);
+		mn.y = std::min(mn.y, t.y);
+		mx.x = std::max(mx.x, t.x);
+		mx.y = std::max(mx.y, t.y);
+	}
+	origin = mn;
+	width = mx.x - mn.x + 1;
+	height = mx.y - mn.y + 1;
+
+	// Counting sort the entities by cell
+	cells.resize(entities.size());
+	offsets.assign(width * height + 1, 0);
+	for (unsigned i = 0; i < entities.size(); ++i) {
+		const auto t = lif::tile2(entities[i]->getPosition());
+		cells[i] = (t.y - origin.y) * width + (t.x - origin.x);
+		++offsets[cells[i] + 1];
+	}
+	for (unsigned c = 1; c < offsets.size(); ++c)
+		offsets[c] += offsets[c - 1];
+
+	entries.resize(entities.size());
+	for (unsigned i = 0; i < entities.size(); ++i)
+		entries[offsets[cells[i]]++] = entities[i].get();
+	// Now offsets[c] is the end of cell c: shift them back by one.
+	for (unsigned c = offsets.size() - 1; c > 0; --c)
+		offsets[c] = offsets[c - 1];
+	offsets[0] = 0;
+}
+
+void TileIndex::clear() {
+	width = height = 0;
+	offsets.assign(1, 0);
+	entries.clear();
+}
+
+TileIndex::Range TileIndex::at(const sf::Vector2i& tile) const {
+	if (!contains(tile))
+		return Range { nullptr, nullptr };
+	const auto c = (tile.y - origin.y) * width + (tile.x - origin.x);
+	return Range { entries.data() + offsets[c], entries.data() + offsets[c + 1] };
+}
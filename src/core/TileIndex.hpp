@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <memory>
+#include <vector>
+
+namespace lif {
+
+class Entity;
+
+/**
+ * A snapshot of which entities are on which tile (as given by `lif::tile2`), used to answer
+ * "what's on this tile?" without scanning all entities. Tiles are stored in compressed form
+ * in flat arrays which are reused across rebuilds.
+ * The snapshot is only valid until entities are moved, added or destroyed: it's meant to be
+ * rebuilt once per frame (see BaseLevelManager::update).
+ */
+class TileIndex final {
+	/** Tile coordinates of the first cell */
+	sf::Vector2i origin;
+	int width = 0,
+	    height = 0;
+	/** The entities on cell `c` are `entries[offsets[c]] .. entries[offsets[c + 1] - 1]` */
+	std::vector<unsigned> offsets;
+	std::vector<lif::Entity*> entries;
+	/** The cell of each entity, only used while rebuilding */
+	std::vector<unsigned> cells;
+
+public:
+	/** The entities on a single tile */
+	struct Range {
+		lif::Entity *const *first;
+		lif::Entity *const *last;
+
+		lif::Entity *const *begin() const { return first; }
+		lif::Entity *const *end() const { return last; }
+	};
+
+	/** Rebuilds the index from scratch. Entities on the same tile keep their relative order. */
+	void rebuild(const std::vector<std::shared_ptr<lif::Entity>>& entities);
+
+	void clear();
+
+	/** @return Whether `tile` is within the indexed area (tiles out of it are always empty) */
+	bool contains(const sf::Vector2i& tile) const {
+		return tile.x >= origin.x && tile.y >= origin.y
+			&& tile.x < origin.x + width && tile.y < origin.y + height;
+	}
+
+	/** @return The entities on `tile` */
+	Range at(const sf::Vector2i& tile) const;
+};
+
+}
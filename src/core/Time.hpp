@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SFML/System/Time.hpp>
+#include <algorithm>
 #include <chrono>
 
 namespace lif {
@@ -24,13 +25,23 @@ class Time final {
 
 	bool skipFrameLock = false;
 
+	// Fixed-timestep mode (see setFixedStep)
+	TimeType fixedStep = 0;
+	TimeType accumulator = 0;
+	TimeType lastFrameTime = 0;
+	bool frameStepped = false;
+
+	TimeType _now() const {
+		return std::chrono::duration_cast<std::chrono::microseconds>(clock.now() - zeroTime).count();
+	}
+
 public:
 	explicit Time()
 		: zeroTime(clock.now())
 	{}
 
 	void update() {
-		const auto now = std::chrono::duration_cast<std::chrono::microseconds>(clock.now() - zeroTime).count();
+		const auto now = _now();
 		const auto delta = now - realTime;
 		prevRealTime = realTime;
 		realTime = now;
@@ -41,6 +52,79 @@ public:
 		skipFrameLock = false;
 	}
 
+	/** Like `update`, but advances the time by exactly `delta` regardless of the real clock.
+	 *  Used to run the simulation at a fixed tick (e.g. by lifish_headless).
+	 *  The resulting delta is not clamped like the real clock's, so that the game time and
+	 *  the sum of the deltas given to the entities advance equally even at low tick rates.
+	 */
+	void step(sf::Time delta) {
+		const auto us = static_cast<TimeType>(delta.asMicroseconds());
+		prevRealTime = realTime;
+		realTime += us;
+
+		prevFrameTime = gameTime;
+		gameTime += static_cast<TimeType>(us * static_cast<double>(timeScale));
+
+		skipFrameLock = true;
+	}
+
+	/** Sets the duration of a simulation step. If `step` is not zero, the simulation advances in steps of
+	 *  exactly `step`, as many times per frame as needed to keep up with the real clock; otherwise it
+	 *  advances once per frame by the (clamped) frame time.
+	 *  In both cases the main loop is expected to be: `beginFrame(); while (nextStep()) { <simulate> }`.
+	 */
+	void setFixedStep(sf::Time step) {
+		fixedStep = static_cast<TimeType>(std::max(step.asMicroseconds(), sf::Int64(0)));
+		accumulator = 0;
+		realTime = lastFrameTime = _now();
+	}
+
+	sf::Time getFixedStep() const {
+		return sf::microseconds(fixedStep);
+	}
+
+	/** Starts a new frame, sampling the real clock. */
+	void beginFrame() {
+		frameStepped = false;
+		if (fixedStep == 0) {
+			update();
+			return;
+		}
+		// Don't try to catch up more than this: if we're that slow, let the game slow down.
+		static constexpr TimeType MAX_ACCUMULATED = 250'000;
+
+		const auto now = _now();
+		accumulator = std::min(accumulator + (now - lastFrameTime), MAX_ACCUMULATED);
+		lastFrameTime = now;
+	}
+
+	/** Advances the time by one simulation step, if there's one due in this frame.
+	 *  @return Whether the time was advanced, i.e. whether the simulation should be updated.
+	 */
+	bool nextStep() {
+		if (fixedStep == 0) {
+			if (frameStepped)
+				return false;
+			frameStepped = true;
+			return true;
+		}
+		if (accumulator < fixedStep)
+			return false;
+		accumulator -= fixedStep;
+		step(sf::microseconds(fixedStep));
+		return true;
+	}
+
+	/** @return How far the real time is between the last simulation step and the next one, from 0 to 1.
+	 *  Used to interpolate the drawn positions between the last two simulation states.
+	 *  This is always 1 when not using a fixed step or when the time is paused.
+	 */
+	float getAlpha() const {
+		if (fixedStep == 0 || timeScale == 0)
+			return 1;
+		return static_cast<float>(accumulator) / fixedStep;
+	}
+
 	sf::Time getGameTime() const {
 		return sf::microseconds(gameTime);
 	}
@@ -0,0 +1,133 @@
+#include "OccupancyGrid.hpp"
+#include "Collider.hpp"
+#include "EntityGroup.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using lif::OccupancyGrid;
+using lif::TILE_SIZE;
+
+OccupancyGrid::OccupancyGrid(const lif::EntityGroup& group)
+	: group(group)
+{}
+
+void OccupancyGrid::setLevelSize(int levelWidth, int levelHeight) {
+	width = levelWidth + 2;
+	height = levelHeight + 2;
+	clear();
+	sync();
+}
+
+void OccupancyGrid::clear() {
+	tiles.assign(width * height, Tile());
+	fixed.clear();
+	transient.clear();
+	fixedGeneration = group.getFixedCollidersGeneration();
+}
+
+bool OccupancyGrid::_track(const lif::Collider& cld, Tracked& tracked) const {
+	tracked.collider = cld.getHandle();
+	tracked.layer = cld.getLayer();
+
+	// Same semantics as sf::FloatRect::intersects: tiles only touching the collider are not counted.
+	const auto rect = cld.getRect();
+	tracked.first = sf::Vector2i(
+			static_cast<int>(std::floor(rect.left / TILE_SIZE)),
+			static_cast<int>(std::floor(rect.top / TILE_SIZE)));
+	tracked.last = sf::Vector2i(
+			static_cast<int>(std::ceil((rect.left + rect.width) / TILE_SIZE)) - 1,
+			static_cast<int>(std::ceil((rect.top + rect.height) / TILE_SIZE)) - 1);
+	tracked.first.x = std::max(0, tracked.first.x);
+	tracked.first.y = std::max(0, tracked.first.y);
+	tracked.last.x = std::min(width - 1, tracked.last.x);
+	tracked.last.y = std::min(height - 1, tracked.last.y);
+
+	return tracked.first.x <= tracked.last.x && tracked.first.y <= tracked.last.y;
+}
+
+void OccupancyGrid::_apply(const Tracked& tracked, bool isFixed, int delta) {
+	const auto layer = tracked.layer;
+	for (int y = tracked.first.y; y <= tracked.last.y; ++y) {
+		for (int x = tracked.first.x; x <= tracked.last.x; ++x) {
+			auto& tile = tiles[y * width + x];
+			auto& count = (isFixed ? tile.fixedCounts : tile.transientCounts)[layer];
+			assert(delta > 0 || count > 0);
+			count += delta;
+			const bool fixedPresent = tile.fixedCounts[layer] > 0,
+			           present = fixedPresent || tile.transientCounts[layer] > 0;
+			tile.fixed = fixedPresent ? (tile.fixed | mask(layer)) : (tile.fixed & ~mask(layer));
+			tile.all = present ? (tile.all | mask(layer)) : (tile.all & ~mask(layer));
+		}
+	}
+}
+
+void OccupancyGrid::_addFixed(lif::Handle<lif::Collider> cld) {
+	// Keep the entry even if it covers no tile, so `fixed` stays aligned with the group's list
+	Tracked tracked;
+	tracked.collider = cld;
+	tracked.layer = lif::c_layers::DEFAULT;
+	tracked.last = sf::Vector2i(-1, -1);
+	const auto ptr = group.get(cld);
+	if (ptr != nullptr && _track(*ptr, tracked))
+		_apply(tracked, true, 1);
+	fixed.emplace_back(tracked);
+}
+
+void OccupancyGrid::sync() {
+	if (tiles.size() == 0) return;
+
+	const auto& groupFixed = group.getFixedColliders();
+	if (fixedGeneration != group.getFixedCollidersGeneration()) {
+		// Some fixed colliders were removed from the group: remove the same ones here.
+		// Since the group's list is pruned preserving the order, `fixed` keeps being its prefix.
+		fixed.erase(std::remove_if(fixed.begin(), fixed.end(), [this] (const Tracked& t) {
+			if (group.get(t.collider) != nullptr)
+				return false;
+			_apply(t, true, -1);
+			return true;
+		}), fixed.end());
+		fixedGeneration = group.getFixedCollidersGeneration();
+	}
+	if (fixed.size() > groupFixed.size()) {
+		// The group was cleared without us knowing: start over.
+		clear();
+	}
+	for (auto i = fixed.size(); i < groupFixed.size(); ++i)
+		_addFixed(groupFixed[i]);
+
+	transient.erase(std::remove_if(transient.begin(), transient.end(), [this] (const Tracked& t) {
+		if (group.get(t.collider) != nullptr)
+			return false;
+		_apply(t, false, -1);
+		return true;
+	}), transient.end());
+}
+
+void OccupancyGrid::addTransient(const lif::Collider& cld) {
+	Tracked tracked;
+	if (tiles.size() == 0 || cld.getHandle().isNull() || !_track(cld, tracked))
+		return;
+	_apply(tracked, false, 1);
+	transient.emplace_back(tracked);
+}
+
+OccupancyGrid::LayerMask OccupancyGrid::getFixedLayers(const sf::Vector2i& tile) const {
+	if (tile.x < 0 || tile.y < 0 || tile.x >= width || tile.y >= height)
+		return 0;
+	return tiles[tile.y * width + tile.x].fixed;
+}
+
+OccupancyGrid::LayerMask OccupancyGrid::getLayers(const sf::Vector2i& tile) const {
+	if (tile.x < 0 || tile.y < 0 || tile.x >= width || tile.y >= height)
+		return 0;
+	return tiles[tile.y * width + tile.x].all;
+}
+
+OccupancyGrid::LayerMask OccupancyGrid::solidFor(lif::c_layers::Layer layer) {
+	LayerMask m = 0;
+	for (unsigned l = 0; l < lif::c_layers::N_LAYERS; ++l)
+		if (lif::c_layers::solid[layer][l])
+			m |= mask(static_cast<lif::c_layers::Layer>(l));
+	return m;
+}
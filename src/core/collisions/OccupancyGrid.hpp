@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Handle.hpp"
+#include "collision_layers.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lif {
+
+class Collider;
+class EntityGroup;
+
+/**
+ * A tile-sized grid keeping track of which collision layers occupy each tile of the level.
+ * It answers "is there a wall / an explosion on this tile?" in O(1), without scanning all colliders.
+ * Two kinds of colliders are tracked:
+ * - the colliders of Fixed entities, which are synced automatically from the EntityGroup;
+ * - "transient" colliders, i.e. non-moving colliders which are added explicitly via `addTransient`
+ *   (e.g. explosions) and are dropped when they expire.
+ * Note that, like EntityGroup::getCollidersIntersecting, this does not care whether colliders are active.
+ */
+class OccupancyGrid final {
+public:
+	/** A bitmask with bit `l` set if layer `l` is present */
+	using LayerMask = std::uint32_t;
+	static_assert(lif::c_layers::N_LAYERS <= 32, "LayerMask is too small!");
+
+private:
+	using Counts = std::array<unsigned short, lif::c_layers::N_LAYERS>;
+
+	struct Tracked {
+		lif::Handle<lif::Collider> collider;
+		lif::c_layers::Layer layer;
+		/** Inclusive range of covered tiles (grid coordinates) */
+		sf::Vector2i first, last;
+	};
+
+	struct Tile {
+		Counts fixedCounts = {},
+		       transientCounts = {};
+		LayerMask fixed = 0,
+		          all = 0;
+	};
+
+	const lif::EntityGroup& group;
+
+	/** Size in tiles, including the level border */
+	int width = 0,
+	    height = 0;
+	std::vector<Tile> tiles;
+
+	/** Mirrors the first `fixed.size()` elements of the group's fixed colliders */
+	std::vector<Tracked> fixed;
+	unsigned fixedGeneration = 0;
+
+	std::vector<Tracked> transient;
+
+	bool _track(const lif::Collider& cld, Tracked& tracked) const;
+	void _apply(const Tracked& tracked, bool isFixed, int delta);
+	void _addFixed(lif::Handle<lif::Collider> cld);
+
+public:
+	explicit OccupancyGrid(const lif::EntityGroup& group);
+
+	/** Sets the size of the level (in tiles, excluding the border) and rebuilds the grid from scratch. */
+	void setLevelSize(int levelWidth, int levelHeight);
+
+	/** Forgets all tracked colliders. */
+	void clear();
+
+	/** Updates the grid with the Fixed colliders added to or removed from the EntityGroup,
+	 *  and drops the expired transient colliders. This should be called once per frame,
+	 *  after the EntityGroup was validated.
+	 */
+	void sync();
+
+	/** Starts tracking the transient collider `cld`, which is not supposed to move.
+	 *  `cld` must already be in the EntityGroup.
+	 */
+	void addTransient(const lif::Collider& cld);
+
+	/** @return The layers of Fixed colliders intersecting `tile` (0 if out of the grid) */
+	LayerMask getFixedLayers(const sf::Vector2i& tile) const;
+	/** @return The layers of all tracked colliders intersecting `tile` (0 if out of the grid) */
+	LayerMask getLayers(const sf::Vector2i& tile) const;
+
+	/** @return The mask of all layers which are solid for `layer` */
+	static LayerMask solidFor(lif::c_layers::Layer layer);
+	static constexpr LayerMask mask(lif::c_layers::Layer layer) { return LayerMask(1) << layer; }
+};
+
+}
@@ -3,88 +3,133 @@
 #include "Direction.hpp"
 #include "EntityGroup.hpp"
 #include "collision_utils.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 
 using namespace lif::collision_utils;
 using lif::SHContainer;
 using lif::SHCollisionDetector;
 
+////// SHContainer::Grid ///////
+void SHContainer::Grid::clear() {
+	objs.clear();
+	ranges.clear();
+	entries.clear();
+	stamps.clear();
+}
+
+void SHContainer::Grid::add(lif::Collider *obj, const CellRange& range) {
+	objs.emplace_back(obj);
+	ranges.emplace_back(range);
+	stamps.emplace_back(0);
+}
+
+void SHContainer::Grid::build(unsigned subdivisions) {
+	// Count the entries of each cell...
+	offsets.assign(subdivisions * subdivisions + 1, 0);
+	for (const auto& r : ranges)
+		for (unsigned j = r.top; j <= r.bottom; ++j)
+			for (unsigned i = r.left; i <= r.right; ++i)
+				++offsets[j * subdivisions + i + 1];
+
+	// ...turn the counts into offsets...
+	for (unsigned c = 1; c < offsets.size(); ++c)
+		offsets[c] += offsets[c - 1];
+
+	// ...and scatter the colliders, using offsets[c] as the insertion point of cell c - 1.
+	entries.resize(offsets.back());
+	for (unsigned k = 0; k < ranges.size(); ++k) {
+		const auto& r = ranges[k];
+		for (unsigned j = r.top; j <= r.bottom; ++j)
+			for (unsigned i = r.left; i <= r.right; ++i)
+				entries[offsets[j * subdivisions + i]++] = k;
+	}
+	// Now offsets[c] is the end of cell c: shift them back by one.
+	for (unsigned c = offsets.size() - 1; c > 0; --c)
+		offsets[c] = offsets[c - 1];
+	offsets[0] = 0;
+}
+
 ////// SHContainer ///////
 SHContainer::SHContainer(const sf::Vector2f& levelSize, unsigned subdivisions)
 	: levelSize(levelSize)
 	, cellSize(levelSize.x / subdivisions, levelSize.y / subdivisions)
 	, subdivisions(subdivisions)
-	, buckets(subdivisions * subdivisions)
-{}
+{
+	dynamic.build(subdivisions);
+	fixed.build(subdivisions);
+}
 
 void SHContainer::clear() {
-	for (auto& b : buckets)
-		b.clear();
-	all.clear();
+	dynamic.clear();
 }
 
-void SHContainer::insert(std::weak_ptr<lif::Collider> obj) {
-	if (obj.expired()) return;
+void SHContainer::clearStatic() {
+	fixed.clear();
+}
 
-	const auto cld = obj.lock();
-	if (!cld->isActive()) return;
+void SHContainer::insert(lif::Collider *cld) {
+	if (cld == nullptr || !cld->isActive()) return;
 
-	const auto ids = _getIdFor(*cld);
-	for (auto id : ids) {
-		buckets[id].emplace_back(obj);
-	}
-	all.emplace_back(obj);
+	dynamic.add(cld, _getCellsFor(*cld));
+}
+
+void SHContainer::insertStatic(lif::Collider *cld) {
+	if (cld == nullptr) return;
+
+	fixed.add(cld, _getCellsFor(*cld));
 }
 
-std::vector<unsigned> SHContainer::_getIdFor(const lif::Collider& obj) const {
-	std::vector<unsigned> ids;
+SHContainer::CellRange SHContainer::_getCellsFor(const lif::Collider& obj) const {
+	if (cellSize.x <= 0 || cellSize.y <= 0)
+		return CellRange { 0, 0, 0, 0 };
 
 	const auto pos = obj.getPosition();
 	const auto size = obj.getSize();
+	const auto cell = [this] (float coord, float csize) -> unsigned short {
+		const int c = static_cast<int>((coord - lif::TILE_SIZE) / csize);
+		return static_cast<unsigned short>(std::max(0, std::min(static_cast<int>(subdivisions) - 1, c)));
+	};
 
-	const sf::Vector2i upleft(
-				(pos.x - lif::TILE_SIZE) / cellSize.x,
-				(pos.y - lif::TILE_SIZE) / cellSize.y),
-	                   downright(
-				(pos.x - lif::TILE_SIZE + size.x) / cellSize.x,
-				(pos.y - lif::TILE_SIZE + size.y) / cellSize.y);
-
-	// Insert the object in all the buckets within its vertices
-	for (int i = upleft.x; i <= downright.x; ++i)
-		for (int j = upleft.y; j <= downright.y; ++j)
-			ids.emplace_back(j * subdivisions + i);
+	return CellRange {
+		cell(pos.x, cellSize.x),
+		cell(pos.y, cellSize.y),
+		cell(pos.x + size.x, cellSize.x),
+		cell(pos.y + size.y, cellSize.y)
+	};
+}
 
-	ids.erase(std::remove_if(ids.begin(), ids.end(), [size = buckets.size()] (auto i) {
-		return i >= size;
-	}), ids.end());
+void SHContainer::getNearby(unsigned idx, std::vector<Nearby>& nearby) {
+	nearby.clear();
 
-#ifndef RELEASE
-	// Check all elements are unique
-	std::sort(ids.begin(), ids.end());
-	assert(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
-#endif
-
-	return ids;
-}
+	if (++queryStamp == 0) {
+		// Wrapped around: forget all previous stamps
+		std::fill(dynamic.stamps.begin(), dynamic.stamps.end(), 0);
+		std::fill(fixed.stamps.begin(), fixed.stamps.end(), 0);
+		queryStamp = 1;
+	}
+	dynamic.stamps[idx] = queryStamp;
 
-auto SHContainer::getNearby(const lif::Collider& obj) const -> std::vector<std::weak_ptr<lif::Collider>> {
-	std::vector<std::weak_ptr<lif::Collider>> nearby;
-	nearby.reserve(64);
-
-	const auto ids = _getIdFor(obj);
-	for (auto id : ids) {
-		//std::cerr << id << ": " << buckets[id].size() << std::endl;
-		for (auto& cld : buckets[id]) {
-			// Don't bother to remove invalid objects here, as this list gets regenerated
-			// at every frame.
-			if (cld.expired()) continue;
-
-			auto oth = cld.lock().get();
-			if (oth != &obj)
-				nearby.emplace_back(cld);
+	const auto& r = dynamic.ranges[idx];
+	for (unsigned j = r.top; j <= r.bottom; ++j) {
+		for (unsigned i = r.left; i <= r.right; ++i) {
+			const auto c = j * subdivisions + i;
+			for (unsigned e = dynamic.offsets[c]; e < dynamic.offsets[c + 1]; ++e) {
+				const auto k = dynamic.entries[e];
+				if (dynamic.stamps[k] == queryStamp) continue;
+				dynamic.stamps[k] = queryStamp;
+				nearby.push_back(Nearby { dynamic.objs[k], false });
+			}
+			for (unsigned e = fixed.offsets[c]; e < fixed.offsets[c + 1]; ++e) {
+				const auto k = fixed.entries[e];
+				if (fixed.stamps[k] == queryStamp) continue;
+				fixed.stamps[k] = queryStamp;
+				if (fixed.objs[k]->isActive())
+					nearby.push_back(Nearby { fixed.objs[k], true });
+			}
 		}
 	}
-	return nearby;
 }
 
 ////// SHCollisionDetector ///////
@@ -103,12 +148,53 @@ void SHCollisionDetector::setLevelLimit(const sf::FloatRect& limit) {
 	container.levelSize = sf::Vector2f(limit.width - limit.left, limit.height - limit.top);
 	container.cellSize = sf::Vector2f(container.levelSize.x / container.subdivisions,
 	                                  container.levelSize.y / container.subdivisions);
+	// Cell ranges depend on the cell size
+	rebuildStatic();
+}
+
+void SHCollisionDetector::rebuildStatic() {
+	container.clearStatic();
+	const auto& fixed = group.getFixedColliders();
+	for (auto h : fixed)
+		container.insertStatic(group.get(h));
+	container.buildStatic();
+	nStaticInserted = fixed.size();
+	staticGeneration = group.getFixedCollidersGeneration();
+}
+
+void SHCollisionDetector::_updateStatic() {
+	if (staticGeneration != group.getFixedCollidersGeneration()) {
+		// Some fixed entity was removed
+		rebuildStatic();
+		return;
+	}
+	// Insert the newly added fixed entities, if any
+	const auto& fixed = group.getFixedColliders();
+	if (nStaticInserted == fixed.size())
+		return;
+	for ( ; nStaticInserted < fixed.size(); ++nStaticInserted)
+		container.insertStatic(group.get(fixed[nStaticInserted]));
+	container.buildStatic();
 }
 
 void SHCollisionDetector::update() {
 #ifndef RELEASE
-	// Container setup time
-	dbgStats.timer.start("setup");
+	// Static grid maintenance time (should be ~0 unless some fixed entity was added or removed)
+	dbgStats.timer.start(LIF_ZONE_ID("cd_static"));
+#endif
+	_updateStatic();
+
+	// Fixed colliders are not reinserted, but the ones which collided last frame must be reset
+	for (auto h : touchedStatic)
+		if (auto cld = group.get(h))
+			cld->reset();
+	touchedStatic.clear();
+
+#ifndef RELEASE
+	dbgStats.timer.end(LIF_ZONE_ID("cd_static"));
+	dbgStats.counter.set("static", group.getFixedColliders().size());
+	// Container setup time (only accounts for non-Fixed colliders)
+	dbgStats.timer.start(LIF_ZONE_ID("cd_setup"));
 #endif
 	container.clear();
 
@@ -116,34 +202,32 @@ void SHCollisionDetector::update() {
 	 * 1) has it reached the level boundaries?
 	 * 2) is there another non-trasparent entity occupying the cell ahead?
 	 */
-	const auto& colliding = group.getColliding();
-	for (auto it = colliding.begin(); it != colliding.end(); ++it) {
-		// No need to check for expired, as EntityGroup prunes them before we're called
-		auto collider = it->lock();
+	const auto& colliding = group.getDynamicColliders();
+	for (auto h : colliding) {
+		// No need to check for null, as EntityGroup prunes stale handles before we're called
+		auto collider = group.get(h);
 		// reset collider
 		collider->reset();
 		collider->setAtLimit(false);
-		container.insert(*it);
+		container.insert(collider);
 	}
+	container.build();
 
 #ifndef RELEASE
-	dbgStats.timer.end("setup");
+	dbgStats.timer.end(LIF_ZONE_ID("cd_setup"));
+	dbgStats.counter.set("dynamic", colliding.size());
 	// Total time taken
-	dbgStats.timer.start("tot");
-	// Time taken by all narrow checks
-	dbgStats.timer.set("tot_narrow", 0);
+	dbgStats.timer.start(LIF_ZONE_ID("cd_tot"));
+	// Time taken by all narrow checks (timed per collider, as timing each pair costs more than checking it)
+	std::uint64_t narrowTime = 0;
 	// Number of narrow-checked entities
-	dbgStats.counter.reset("checked");
+	int nChecked = 0;
 #endif
 
 	// Collision detection loop
-	const auto& all = container.getAll();
-	for (auto it = all.begin(); it != all.end(); ++it) {
-		auto collider = it->lock();
-
-		// Fixed entities only collide passively
-		if (collider->getOwner().get<lif::Fixed>() != nullptr)
-			continue;
+	const auto& all = container.dynamic;
+	for (unsigned k = 0; k < all.objs.size(); ++k) {
+		auto collider = all.objs[k];
 
 		const auto moving = collider->getOwner().get<lif::Moving>();
 		const auto axismoving = moving ? dynamic_cast<lif::AxisMoving*>(moving) : nullptr;
@@ -152,13 +236,14 @@ void SHCollisionDetector::update() {
 			continue;
 		}
 
-		for (auto oth : container.getNearby(*collider)) {
-			if (oth.expired()) continue;
+		container.getNearby(k, nearby);
 #ifndef RELEASE
-			dbgStats.counter.inc("checked");
-			dbgStats.timer.start("single");
+		nChecked += nearby.size();
+		const auto narrowStart = lif::debug::Tracer::now();
 #endif
-			auto othcollider = oth.lock().get();
+		for (const auto& oth : nearby) {
+			auto othcollider = oth.collider;
+			bool ack = false;
 
 			if (axismoving) {
 				// Only check entities ahead of this one
@@ -169,29 +254,32 @@ void SHCollisionDetector::update() {
 						&& collide(*collider, *othcollider, axismoving->getDirection()))
 				{
 					//std::cerr << &collider->getOwner() << " colliding with " << &othcollider->getOwner()<<std::endl;
-					collider->addColliding(oth);
-					if (collider->requestsForceAck() || othcollider->requestsForceAck()
-							|| othcollider->getOwner().get<lif::Moving>() == nullptr)
-					{
-						// Let the entity know we collided with it.
-						// We only do that for non-moving entities to avoid problems with
-						// multiple collisions between two moving entities.
-						othcollider->addColliding(*it);
-					}
+					collider->addColliding(*othcollider);
+					// Let the entity know we collided with it.
+					// We only do that for non-moving entities to avoid problems with
+					// multiple collisions between two moving entities.
+					ack = collider->requestsForceAck() || othcollider->requestsForceAck()
+							|| othcollider->getOwner().get<lif::Moving>() == nullptr;
 				}
 			} else if (collider->contains(*othcollider) && collider->collidesWith(*othcollider)) {
-				collider->addColliding(oth);
-				othcollider->addColliding(*it);
+				collider->addColliding(*othcollider);
+				ack = true;
 			}
 
+			if (ack) {
+				othcollider->addColliding(*collider);
+				if (oth.fixed)
+					touchedStatic.emplace_back(othcollider->getHandle());
+			}
+		}
 #ifndef RELEASE
-			dbgStats.timer.set("tot_narrow", dbgStats.timer.get("tot_narrow")
-					+ dbgStats.timer.end("single"));
+		narrowTime += lif::debug::Tracer::now() - narrowStart;
 #endif
-		}
 	}
 
 #ifndef RELEASE
-	dbgStats.timer.end("tot");
+	dbgStats.timer.end(LIF_ZONE_ID("cd_tot"));
+	dbgStats.timer.set(LIF_ZONE_ID("cd_tot_narrow"), narrowTime * 1e-9);
+	dbgStats.counter.set("checked", nChecked);
 #endif
 }
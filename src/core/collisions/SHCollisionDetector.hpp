@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CollisionDetector.hpp"
+#include "Handle.hpp"
 #include <SFML/System/Vector2.hpp>
 #include <memory>
 #include <vector>
@@ -13,36 +14,81 @@ class Collider;
 class SHCollisionDetector;
 
 /**
- * Container for spatial hashing algorithm. Has `subdivision^2` buckets.
+ * Container for spatial hashing algorithm. Has `subdivision^2` cells.
+ * Colliders of Fixed entities live in a separate grid which persists across frames,
+ * while the other ones are cleared and reinserted every frame.
+ * Both grids are stored in compressed form (CSR) and reuse their memory, so that, after
+ * the first few frames, the broad phase doesn't allocate anything.
  */
 class SHContainer final {
-	using Bucket = std::vector<std::weak_ptr<lif::Collider>>;
-
 	friend class SHCollisionDetector;
 
+	/** The (inclusive) range of cells covered by a collider */
+	struct CellRange {
+		unsigned short left, top, right, bottom;
+	};
+
+	/** A set of colliders bucketed by cell */
+	struct Grid {
+		/** Each collider, as a raw pointer (valid until its owner leaves the EntityGroup) */
+		std::vector<lif::Collider*> objs;
+		/** The cells covered by each collider */
+		std::vector<CellRange> ranges;
+		/** The colliders in cell `c` are `entries[offsets[c]] .. entries[offsets[c + 1] - 1]` */
+		std::vector<unsigned> offsets;
+		/** Indexes into `objs`, grouped by cell */
+		std::vector<unsigned> entries;
+		/** The latest query that returned each collider, used to de-duplicate the results */
+		std::vector<unsigned> stamps;
+
+		void clear();
+		void add(lif::Collider *obj, const CellRange& range);
+		/** Fills `offsets` and `entries` from the colliders added so far (counting sort) */
+		void build(unsigned subdivisions);
+	};
+
+	/** A collider returned by `getNearby` */
+	struct Nearby {
+		lif::Collider *collider;
+		bool fixed;
+	};
+
 	sf::Vector2f levelSize,
 	             cellSize;
 	unsigned subdivisions;
-	std::vector<Bucket> buckets;
-	Bucket all;
+	/** Non-Fixed colliders, rebuilt every frame */
+	Grid dynamic;
+	/** Fixed colliders, persistent */
+	Grid fixed;
+	/** Incremented at every `getNearby` */
+	unsigned queryStamp = 0;
 
-	/** @return A vector of bucket indexes for the buckets containing `obj`. */
-	std::vector<unsigned> _getIdFor(const lif::Collider& obj) const;
+	CellRange _getCellsFor(const lif::Collider& obj) const;
 
 public:
 	SHContainer(const sf::Vector2f& levelSize, unsigned subdivisions);
 
 	unsigned getSubdivisions() const { return subdivisions; }
 
+	/** Removes all non-Fixed colliders */
 	void clear();
-	void insert(std::weak_ptr<lif::Collider> obj);
-	/** @return A set of all colliders in an adjacent cell to `obj`. */
-	auto getNearby(const lif::Collider& obj) const -> std::vector<std::weak_ptr<lif::Collider>>;
-	/** @return The flattened vector of all colliders. This may differ from EntityGroup::getColliding
-	 *  as the colliders which are actually considered by SHContainer are filtered through some
-	 *  criteria (e.g. they must be active)
+	/** Removes all Fixed colliders */
+	void clearStatic();
+	/** Inserts the non-Fixed collider `cld`. Does nothing if it's not active.
+	 *  Once all colliders are inserted, `build` must be called.
+	 */
+	void insert(lif::Collider *cld);
+	/** Inserts the Fixed collider `cld`. Unlike `insert`, this also accepts inactive
+	 *  colliders, as activity is checked when querying.
+	 *  Once all colliders are inserted, `buildStatic` must be called.
 	 */
-	auto getAll() const -> const std::vector<std::weak_ptr<lif::Collider>>& { return all; }
+	void insertStatic(lif::Collider *cld);
+	void build() { dynamic.build(subdivisions); }
+	void buildStatic() { fixed.build(subdivisions); }
+	/** Fills `nearby` with all active colliders sharing a cell with the `idx`-th non-Fixed collider,
+	 *  each one appearing only once.
+	 */
+	void getNearby(unsigned idx, std::vector<Nearby>& nearby);
 };
 
 /**
@@ -51,6 +97,20 @@ public:
 class SHCollisionDetector final : public lif::CollisionDetector {
 	SHContainer container;
 
+	/** How many of the group's fixed colliders are in the static grid */
+	std::size_t nStaticInserted = 0;
+	/** The group's fixed colliders generation the static grid was built from */
+	unsigned staticGeneration = 0;
+	/** Fixed colliders which were notified of a collision during the latest update
+	 *  (these are the only ones needing a reset)
+	 */
+	std::vector<lif::Handle<lif::Collider>> touchedStatic;
+	/** Reused by `update` to hold the result of `getNearby` */
+	std::vector<SHContainer::Nearby> nearby;
+
+	/** Brings the static grid up to date with the group's fixed colliders */
+	void _updateStatic();
+
 public:
 	explicit SHCollisionDetector(lif::EntityGroup& group,
 				const sf::FloatRect& levelLimit = sf::FloatRect(0, 0, 0, 0),
@@ -61,6 +121,12 @@ public:
 	unsigned getSubdivisions() const { return container.getSubdivisions(); }
 
 	void setLevelLimit(const sf::FloatRect& limit) override;
+
+	/** Rebuilds the static grid from all the group's fixed colliders.
+	 *  This should be called after loading a level; afterwards, `update` takes care of
+	 *  keeping it in sync as fixed entities are added or removed.
+	 */
+	void rebuildStatic();
 };
 
 }
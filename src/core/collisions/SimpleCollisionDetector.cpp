@@ -22,10 +22,10 @@ void SimpleCollisionDetector::update() {
 	 * 1) has it reached the level boundaries?
 	 * 2) is there another non-trasparent entity occupying the cell ahead?
 	 */
-	auto& colliding = group.getColliding();
-	for (auto& cld : colliding) {
-		// No need to check for expired, as EntityGroup prunes them before we're called
-		auto collider = cld.lock();
+	const auto& colliding = group.getColliding();
+	for (auto h : colliding) {
+		// No need to check for null, as EntityGroup prunes stale handles before we're called
+		auto collider = group.get(h);
 		// reset collider
 		collider->reset();
 		collider->setAtLimit(false);
@@ -33,16 +33,16 @@ void SimpleCollisionDetector::update() {
 
 #ifndef RELEASE
 	// Total time taken
-	dbgStats.timer.start("tot");
+	dbgStats.timer.start(LIF_ZONE_ID("cd_tot"));
 	// Time taken by all narrow checks
-	dbgStats.timer.set("tot_narrow", 0);
+	dbgStats.timer.set(LIF_ZONE_ID("cd_tot_narrow"), 0);
 	// Number of narrow-checked entities
 	dbgStats.counter.reset("checked");
 #endif
 
 	// Collision detection loop
 	for (auto it = colliding.begin(); it != colliding.end(); ++it) {
-		auto collider = it->lock();
+		auto collider = group.get(*it);
 
 		// Fixed entities only collide passively
 		if (collider->getOwner().get<lif::Fixed>() != nullptr)
@@ -61,10 +61,10 @@ void SimpleCollisionDetector::update() {
 
 #ifndef RELEASE
 			dbgStats.counter.inc("checked");
-			dbgStats.timer.start("single");
+			dbgStats.timer.start(LIF_ZONE_ID("cd_single"));
 #endif
 
-			auto othcollider = jt->lock();
+			auto othcollider = group.get(*jt);
 			if (axismoving) {
 				// Only check entities ahead of this one
 				if (!directionIsViable(*collider, *axismoving, *othcollider))
@@ -74,31 +74,31 @@ void SimpleCollisionDetector::update() {
 						&& collide(*collider, *othcollider, axismoving->getDirection()))
 				{
 					//std::cerr << &collider->getOwner() << " colliding with " << &othcollider->getOwner()<<std::endl;
-					collider->addColliding(*jt);
+					collider->addColliding(*othcollider);
 					if (collider->requestsForceAck() || othcollider->requestsForceAck()
 							|| othcollider->getOwner().get<lif::Moving>() == nullptr)
 					{
 						// Let the entity know we collided with it.
 						// We only do that for non-moving entities to avoid problems with
 						// multiple collisions between two moving entities.
-						othcollider->addColliding(*it);
+						othcollider->addColliding(*collider);
 						//std::cerr << "[moving] colliding\n";
 					}
 				}
 			} else if (collider->contains(*othcollider) && collider->collidesWith(*othcollider)) {
 				//std::cerr << &collider->getOwner() << " colliding with " << &othcollider->getOwner()<<std::endl;
-				collider->addColliding(*jt);
-				othcollider->addColliding(*it);
+				collider->addColliding(*othcollider);
+				othcollider->addColliding(*collider);
 			}
 
 #ifndef RELEASE
-			dbgStats.timer.set("tot_narrow", dbgStats.timer.get("tot_narrow")
-					+ dbgStats.timer.end("single"));
+			dbgStats.timer.set(LIF_ZONE_ID("cd_tot_narrow"), dbgStats.timer.get(LIF_ZONE_ID("cd_tot_narrow"))
+					+ dbgStats.timer.end(LIF_ZONE_ID("cd_single")));
 #endif
 		}
 	}
 
 #ifndef RELEASE
-	dbgStats.timer.end("tot");
+	dbgStats.timer.end(LIF_ZONE_ID("cd_tot"));
 #endif
 }
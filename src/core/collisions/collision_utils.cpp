@@ -98,9 +98,10 @@ std::vector<sf::Vector2i> lif::collision_utils::findFreeTiles(const lif::BaseLev
 		touched.emplace_back(lif::tile(pos + sf::Vector2f(size.x - 1, size.y - 1)));
 		return touched;
 	};
-	for (auto wcld : lm.getEntities().getColliding()) {
-		if (wcld.expired()) continue;
-		const auto cld = wcld.lock();
+	const auto& entities = lm.getEntities();
+	for (auto h : entities.getColliding()) {
+		const auto cld = entities.get(h);
+		if (cld == nullptr) continue;
 		const auto touched = touchedTiles(cld);
 		free.erase(std::remove_if(free.begin(), free.end(), [&touched] (const auto& pos) {
 			return std::find(touched.begin(), touched.end(), pos) != touched.end();
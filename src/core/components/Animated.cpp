@@ -10,7 +10,12 @@ Animated::Animated(lif::Entity& owner, const std::string& textureName)
 	: lif::Component(owner)
 {
 	_declComponent<Animated>();
-	texture = lif::cache.loadTexture(textureName);
+	texture = lif::cache.acquireTexture(textureName);
+	acquiredTexture = texture;
+}
+
+Animated::~Animated() {
+	lif::cache.releaseTexture(acquiredTexture);
 }
 
 Animation& Animated::addAnimation(lif::StringId name) {
@@ -2,6 +2,7 @@
 
 #include "AnimatedSprite.hpp"
 #include "Animation.hpp"
+#include "Batchable.hpp"
 #include "Component.hpp"
 #include "sid.hpp"
 #include <SFML/Graphics.hpp>
@@ -15,7 +16,10 @@ namespace lif {
  * An Animated is a drawable object whose sprite has a certain
  * number of associated animations.
  */
-class Animated : public lif::Component, public sf::Drawable {
+class Animated : public lif::Component, public sf::Drawable, public lif::Batchable {
+	/** The texture acquired from the cache, which `texture` may have been changed from */
+	const sf::Texture *acquiredTexture;
+
 protected:
 	sf::Texture *texture;
 	std::unordered_map<lif::StringId, Animation> animations;
@@ -28,6 +32,7 @@ public:
 	COMP_NOT_UNIQUE
 
 	explicit Animated(lif::Entity& owner, const std::string& texture_name);
+	~Animated();
 
 	/** Adds a new empty animation to this Animated and returns it */
 	Animation& addAnimation(StringId name);
@@ -73,6 +78,10 @@ public:
 	void update() override;
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+	/** Implements Batchable */
+	const sf::Texture* getBatchQuad(sf::Vertex *quad) const override {
+		return animatedSprite.getQuad(quad);
+	}
 
 	void setOrigin(const sf::Vector2f& o) override {
 		lif::Component::setOrigin(o);
@@ -2,36 +2,9 @@
 #include "utils.hpp"
 #include "Collider.hpp"
 #include "EntityGroup.hpp"
-#include <array>
 
 using lif::AxisSighted;
 
-// Helper functions for _fillLine
-static bool checkUp(const sf::Vector2i& etile, const sf::Vector2i& mtile) {
-	return etile.x == mtile.x && etile.y < mtile.y;
-}
-
-static bool checkDown(const sf::Vector2i& etile, const sf::Vector2i& mtile) {
-	return etile.x == mtile.x && etile.y > mtile.y;
-}
-
-static bool checkLeft(const sf::Vector2i& etile, const sf::Vector2i& mtile) {
-	return etile.y == mtile.y && etile.x < mtile.x;
-}
-
-static bool checkRight(const sf::Vector2i& etile, const sf::Vector2i& mtile) {
-	return etile.y == mtile.y && etile.x > mtile.x;
-}
-
-static const std::array<std::function<bool(const sf::Vector2i&, const sf::Vector2i&)>, 4> helper_funcs = {{
-	checkUp,
-	checkLeft,
-	checkDown,
-	checkRight
-}};
-// end helper functions
-
-
 AxisSighted::AxisSighted(lif::Entity& owner, float visionRadius)
 	: lif::Sighted(owner, visionRadius)
 {
@@ -53,39 +26,34 @@ void AxisSighted::_fillLine(lif::Direction dir) {
 	// no check for lm != nullptr as it's done beforehand by update()
 
 	const auto mtile = lif::tile2(owner.getPosition());
-	const auto same_line = helper_funcs[static_cast<std::size_t>(dir)];
+	const auto step = sf::Vector2i(lif::directionToVersor(dir));
+	const auto& index = entities->getTileIndex();
 
 	seen[dir].clear();
 
-	entities->apply([&] (const lif::Entity& e) {
-		if (&e == &owner)
-			return;
-		const auto etile = lif::tile2(e.getPosition());
-		if (!same_line(etile, mtile)) return;
-		const auto dist = lif::manhattanDistance(etile, mtile);
-		if (visionRadius < 0 || dist <= visionRadius) {
-			// Only see living entities (including those who are killed but whose kill is in progress)
-			const auto killable = e.get<lif::Killable>();
-			if (killable == nullptr || !killable->isKilled() || killable->isKillInProgress())
-				seen[dir].emplace_back(const_cast<lif::Entity*>(&e), dist);
-		}
-	});
+	// Walk the tiles along `dir`, nearest first, until the vision radius, the end of the
+	// indexed area or an opaque entity is reached.
+	for (unsigned dist = 1; visionRadius < 0 || dist <= visionRadius; ++dist) {
+		const auto tile = mtile + static_cast<int>(dist) * step;
+		if (!index.contains(tile))
+			break;
 
-	std::sort(seen[dir].begin(), seen[dir].end(), [] (const SeenPair& a, const SeenPair& b) {
-		return a.second < b.second;
-	});
-
-	if (opaqueMask != 0) {
-		/* Discard entities farther than an opaque one.
-		 * NOTE THAT at the moment only the first collider of the entity is used
-		 * to determine opaqueness; this assumes that we only see entities whose
-		 * first collider determines their bounding box.
-		 */
-		for (auto it = seen[dir].begin(); it != seen[dir].end(); ++it) {
-			const auto cld = it->first->get<lif::Collider>();
-			if (cld != nullptr) {
-				const auto layer = cld->getLayer();
-				if (_isOpaque(layer)) {
+		for (auto e : index.at(tile)) {
+			if (e == &owner)
+				continue;
+			// Only see living entities (including those who are killed but whose kill is in progress)
+			const auto killable = e->get<lif::Killable>();
+			if (killable != nullptr && killable->isKilled() && !killable->isKillInProgress())
+				continue;
+
+			if (opaqueMask != 0) {
+				/* Don't see past opaque entities.
+				 * NOTE THAT at the moment only the first collider of the entity is used
+				 * to determine opaqueness; this assumes that we only see entities whose
+				 * first collider determines their bounding box.
+				 */
+				const auto cld = e->get<lif::Collider>();
+				if (cld != nullptr && _isOpaque(cld->getLayer())) {
 					switch (dir) {
 					case lif::Direction::DOWN:
 					case lif::Direction::UP:
@@ -98,10 +66,11 @@ void AxisSighted::_fillLine(lif::Direction dir) {
 					default:
 						break;
 					}
-					seen[dir].erase(it, seen[dir].end());
-					break;
+					return;
 				}
 			}
+
+			seen[dir].emplace_back(e, dist);
 		}
 	}
 }
@@ -42,35 +42,35 @@ Collider::Collider(const lif::Collider& other)
 void Collider::update() {
 	lif::Component::update();
 
-	if (onCollision)
+	if (onCollision && registry != nullptr)
 		for (unsigned i = 0; i < colliding.size(); ++i) {
-			auto cld = colliding[i];
-			if (!cld.expired())
-				onCollision(*cld.lock());
+			if (auto cld = registry->get(colliding[i]))
+				onCollision(*cld);
 		}
 }
 
 bool Collider::collidesWithSolid() const {
 	if (atLimit) return true;
-	for (auto c : colliding)
-		if (!c.expired() && c.lock()->isSolidFor(*this))
+	if (registry == nullptr) return false;
+	for (auto h : colliding) {
+		const auto cld = registry->get(h);
+		if (cld != nullptr && cld->isSolidFor(*this))
 			return true;
+	}
 	return false;
 }
 
 bool Collider::collidesWithSolid(const sf::Vector2f& direction) const {
 	if (atLimit) return true;
+	if (registry == nullptr) return false;
 
 	const auto ownerPos = getOwner().getPosition();
-	for (auto c : colliding) {
-		if (c.expired())
-			continue;
-
-		const auto cld = c.lock();
-		if (!cld->isSolidFor(*this))
+	for (auto h : colliding) {
+		const auto cld = registry->get(h);
+		if (cld == nullptr || !cld->isSolidFor(*this))
 			continue;
 
-		const auto othowner = cld->getOwner();
+		const auto& othowner = cld->getOwner();
 		if (lif::dot(othowner.getPosition() - ownerPos, direction) > 0)
 			return true;
 	}
@@ -90,17 +90,22 @@ bool Collider::isSolidFor(const lif::Collider& other) const {
 	return lif::c_layers::solid[layer][other.layer];
 }
 
-std::vector<std::weak_ptr<Collider>> Collider::getColliding() const {
-	return colliding;
+std::vector<Collider*> Collider::getColliding() const {
+	std::vector<Collider*> clds;
+	if (registry == nullptr) return clds;
+	clds.reserve(colliding.size());
+	for (auto h : colliding)
+		if (auto cld = registry->get(h))
+			clds.emplace_back(cld);
+	return clds;
 }
 
-void Collider::addColliding(std::weak_ptr<lif::Collider> coll) {
+void Collider::addColliding(const lif::Collider& coll) {
+	if (registry == nullptr || coll.registry != registry)
+		return;
 	// avoid duplicates
-	if (std::find_if(colliding.begin(), colliding.end(), [&coll] (std::weak_ptr<lif::Collider> oth) {
-		return !oth.expired() && oth.lock().get() == coll.lock().get();
-	}) == colliding.end()) {
-		colliding.emplace_back(coll);
-	}
+	if (std::find(colliding.begin(), colliding.end(), coll.handle) == colliding.end())
+		colliding.emplace_back(coll.handle);
 }
 
 bool Collider::contains(const lif::Collider& other) const {
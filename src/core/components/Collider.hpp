@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.hpp"
+#include "Handle.hpp"
 #include "collision_layers.hpp"
 #include <SFML/Graphics.hpp>
 #include <functional>
@@ -8,15 +9,26 @@
 
 namespace lif {
 
+class EntityGroup;
+
 class Collider : public lif::Component {
+	friend class lif::EntityGroup;
+
+	/** This collider's handle and the table it belongs to. These are set by the EntityGroup
+	 *  this collider's owner is added to (unless the collider is phantom).
+	 */
+	lif::Handle<lif::Collider> handle;
+	const lif::SlotTable<lif::Collider> *registry = nullptr;
+
+
 public:
 	using CollisionFunc = std::function<void(lif::Collider&)>;
 
 protected:
 	const bool phantom;
 
-	/** All the Colliders which are colliding with this one */
-	std::vector<std::weak_ptr<lif::Collider>> colliding;
+	/** All the Colliders which are colliding with this one. They all come from `registry`. */
+	std::vector<lif::Handle<lif::Collider>> colliding;
 	/** Whether this entity is at a level's boundary */
 	bool atLimit = false;
 
@@ -47,10 +59,17 @@ public:
 
 	Collider(const lif::Collider& other);
 
-	/** @return the list of Colliders colliding with this one */
-	std::vector<std::weak_ptr<lif::Collider>> getColliding() const;
-	/** Manually sets `coll` to be colliding with this collider */
-	void addColliding(std::weak_ptr<lif::Collider> coll);
+	/** @return This collider's handle in its EntityGroup (a null handle if it's in none) */
+	lif::Handle<lif::Collider> getHandle() const { return handle; }
+
+	/** @return the list of (still existing) Colliders colliding with this one.
+	 *  NOTE: these pointers are only guaranteed to be valid until the next call to EntityGroup::updateAll().
+	 */
+	std::vector<lif::Collider*> getColliding() const;
+	/** Manually sets `coll` to be colliding with this collider.
+	 *  `coll` must belong to the same EntityGroup as this collider (otherwise this is a no-op).
+	 */
+	void addColliding(const lif::Collider& coll);
 	/** Resets the list of colliding entities */
 	void reset();
 
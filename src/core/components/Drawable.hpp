@@ -3,12 +3,15 @@
 #include <cmath>
 #include <SFML/Graphics.hpp>
 #include "Angle.hpp"
+#include "Batchable.hpp"
 #include "Component.hpp"
 
 namespace lif {
 
 class Drawable : public lif::Component, public sf::Drawable {
 	const sf::Drawable& delegate;
+	/** The delegate, if it's Batchable */
+	const lif::Batchable *batchable;
 	sf::Vector2f rotOrigin;
 	lif::Angle rotation;
 	sf::Vector2f scaleOrigin;
@@ -18,6 +21,7 @@ public:
 	explicit Drawable(lif::Entity& owner, const sf::Drawable& delegate)
 		: lif::Component(owner)
 		, delegate(delegate)
+		, batchable(dynamic_cast<const lif::Batchable*>(&delegate))
 		, scale(1, 1)
 	{
 		_declComponent<Drawable>();
@@ -40,7 +44,7 @@ public:
 					    itrans(1.f, 0.f, -owner.getPosition().x - rotOrigin.x,
 						   0.f, 1.f, -owner.getPosition().y - rotOrigin.y,
 						   0.f, 0.f, 1.f);
-			states.transform = trans * rot * itrans;
+			states.transform *= trans * rot * itrans;
 		}
 		if (scale.x != 1 || scale.y != 1) {
 			// Apply scale
@@ -59,6 +63,13 @@ public:
 		window.draw(delegate, states);
 	}
 
+	/** @see lif::Batchable. This is never batched if rotated or scaled. */
+	const sf::Texture* getBatchQuad(sf::Vertex *quad) const {
+		if (batchable == nullptr || rotation != lif::Angle::Zero || scale.x != 1 || scale.y != 1)
+			return nullptr;
+		return batchable->getBatchQuad(quad);
+	}
+
 	void setRotOrigin(float x, float y) { rotOrigin.x = x; rotOrigin.y = y; }
 	void setRotation(lif::Angle a) { rotation = a; }
 	lif::Angle getRotation() const { return rotation; }
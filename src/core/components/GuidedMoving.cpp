@@ -28,6 +28,7 @@ GuidedMoving::GuidedMoving(lif::Entity& owner,
 
 void GuidedMoving::update() {
 	lif::Component::update();
+	prevPosition = owner.getPosition();
 
 	// Calculate this once here
 	tPerc += lif::time.getDelta() / timeTaken;
@@ -45,6 +45,12 @@ void HurtDrawProxy::draw(sf::RenderTarget& window, sf::RenderStates states) cons
 	}
 }
 
+const sf::Texture* HurtDrawProxy::getBatchQuad(sf::Vertex *quad) const {
+	if (isHurt())
+		return nullptr;
+	return animated->getBatchQuad(quad);
+}
+
 void HurtDrawProxy::hurt() {
 	hurtT = sf::Time::Zero;
 }
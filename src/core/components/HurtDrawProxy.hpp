@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Batchable.hpp"
 #include "Component.hpp"
 #include <SFML/Graphics.hpp>
 
@@ -12,7 +13,7 @@ class Animated;
  * that changes the owner's sprite color to red for a moment after being hurt
  * (used by bosses etc).
  */
-class HurtDrawProxy : public lif::Component, public sf::Drawable {
+class HurtDrawProxy : public lif::Component, public sf::Drawable, public lif::Batchable {
 	lif::Animated *animated = nullptr;
 	sf::Time hurtT = sf::Time::Zero;
 
@@ -27,6 +28,8 @@ public:
 	lif::Entity* init() override;
 	void update() override;
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+	/** Implements Batchable: this can be batched while not showing the hurt effect */
+	const sf::Texture* getBatchQuad(sf::Vertex *quad) const override;
 };
 
 }
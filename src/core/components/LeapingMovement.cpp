@@ -1,7 +1,6 @@
 #include "LeapingMovement.hpp"
 #include "AxisMoving.hpp"
 #include "utils.hpp"
-#include <random>
 
 using lif::LeapingMovement;
 
@@ -18,8 +17,7 @@ lif::Entity* LeapingMovement::init() {
 	if (moving == nullptr)
 		throw std::invalid_argument("Owner of LeapingMovement has no AxisMoving!");
 
-	std::uniform_real_distribution<float> dist(0, blockTime.asSeconds());
-	moving->block(sf::seconds(dist(lif::rng)));
+	moving->block(sf::seconds(getRandom().nextFloat(0, blockTime.asSeconds())));
 
 	return this;
 }
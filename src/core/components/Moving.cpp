@@ -1,6 +1,8 @@
 #include "Moving.hpp"
 #include "Collider.hpp"
 #include "Time.hpp"
+#include "core.hpp"
+#include <cmath>
 
 using lif::Moving;
 
@@ -19,6 +21,7 @@ lif::Entity* Moving::init() {
 
 	// optional
 	collider = owner.get<lif::Collider>();
+	prevPosition = owner.getPosition();
 
 	return this;
 }
@@ -26,6 +29,7 @@ lif::Entity* Moving::init() {
 void Moving::update() {
 	lif::Component::update();
 
+	prevPosition = owner.getPosition();
 	blockT += lif::time.getDelta();
 	distTravelledThisFrame = 0;
 }
@@ -68,6 +72,14 @@ float Moving::_effectiveSpeed() const {
 	return speed + dashAmount * originalSpeed;
 }
 
+sf::Vector2f Moving::getRenderOffset(float alpha) const {
+	const auto diff = owner.getPosition() - prevPosition;
+	// Don't interpolate teleports and other sudden jumps
+	if (std::abs(diff.x) + std::abs(diff.y) > lif::TILE_SIZE)
+		return sf::Vector2f(0, 0);
+	return diff * (alpha - 1);
+}
+
 void Moving::setSpeed(float _speed, bool relativeToOriginal) {
 	speed = _speed * (relativeToOriginal ? originalSpeed : 1);
 }
@@ -31,6 +31,9 @@ protected:
 	float distTravelled = 0;
 	float distTravelledThisFrame = 0;
 
+	/** The owner's position at the beginning of the last update, used to interpolate its drawn position */
+	sf::Vector2f prevPosition;
+
 	sf::Time blockTime = sf::Time::Zero;
 	sf::Time blockT;
 
@@ -89,6 +92,11 @@ public:
 
 	virtual bool isMoving() const { return moving; }
 
+	/** @return The offset to add to the owner's drawn position to place it between its positions
+	 *  before and after the last update; `alpha` is the fraction of the way (see lif::Time::getAlpha).
+	 */
+	sf::Vector2f getRenderOffset(float alpha) const;
+
 	virtual lif::Entity* init() override;
 	virtual void update() override;
 };
@@ -8,6 +8,8 @@ Sighted::Sighted(lif::Entity& owner, float visionRadius)
 	, visionRadius(visionRadius)
 {
 	_declComponent<Sighted>();
+	// Seeing only reads the other entities
+	concurrentUpdate = true;
 }
 
 void Sighted::setOpaque(std::initializer_list<lif::c_layers::Layer> layers, bool opaque) {
@@ -8,10 +8,14 @@ Sprite::Sprite(lif::Entity& owner, const std::string& texture_name)
 	: lif::Component(owner)
 {
 	_declComponent<Sprite>();
-	texture = lif::cache.loadTexture(texture_name);
+	texture = lif::cache.acquireTexture(texture_name);
 	sprite.setTexture(*texture);
 }
 
+Sprite::~Sprite() {
+	lif::cache.releaseTexture(texture);
+}
+
 Sprite::Sprite(lif::Entity& owner, const std::string& texture_name,
 		const sf::IntRect& division)
 	: Sprite(owner, texture_name)
@@ -29,6 +33,29 @@ void Sprite::draw(sf::RenderTarget& target, sf::RenderStates states) const {
 	target.draw(sprite, states);
 }
 
+const sf::Texture* Sprite::getBatchQuad(sf::Vertex *quad) const {
+	const auto tex = sprite.getTexture();
+	if (tex == nullptr)
+		return nullptr;
+
+	// Same vertices as sf::Sprite's, in sf::Quads order
+	const auto bounds = sprite.getLocalBounds();
+	const auto& rect = sprite.getTextureRect();
+	const float left = rect.left,
+	            right = left + rect.width,
+	            top = rect.top,
+	            bottom = top + rect.height;
+	const auto& transform = sprite.getTransform();
+	quad[0] = sf::Vertex(transform.transformPoint(0, 0), sprite.getColor(), sf::Vector2f(left, top));
+	quad[1] = sf::Vertex(transform.transformPoint(0, bounds.height), sprite.getColor(),
+			sf::Vector2f(left, bottom));
+	quad[2] = sf::Vertex(transform.transformPoint(bounds.width, bounds.height), sprite.getColor(),
+			sf::Vector2f(right, bottom));
+	quad[3] = sf::Vertex(transform.transformPoint(bounds.width, 0), sprite.getColor(),
+			sf::Vector2f(right, top));
+	return tex;
+}
+
 void Sprite::update() {
 	lif::Component::update();
 	if (manualPosition)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include "Batchable.hpp"
 #include "Component.hpp"
 
 namespace lif {
@@ -8,7 +9,7 @@ namespace lif {
 /**
  * A drawable non-animated sprite
  */
-class Sprite : public lif::Component, public sf::Drawable {
+class Sprite : public lif::Component, public sf::Drawable, public lif::Batchable {
 	bool manualPosition = false;
 
 protected:
@@ -21,8 +22,11 @@ public:
 	explicit Sprite(lif::Entity& owner, const std::string& texture_name);
 	explicit Sprite(lif::Entity& owner, const std::string& texture_name,
 			const sf::IntRect& textureDivision);
+	~Sprite();
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+	/** Implements Batchable */
+	const sf::Texture* getBatchQuad(sf::Vertex *quad) const override;
 
 	sf::Texture* getTexture() const { return texture; }
 	sf::Sprite& getSprite() { return sprite; }
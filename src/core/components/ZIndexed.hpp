@@ -1,11 +1,13 @@
 #pragma once
 
 #include "Component.hpp"
+#include <functional>
 
 namespace lif {
 
 class ZIndexed : public lif::Component {
 	int zIndex = 0;
+	std::function<void()> onChange;
 public:
 	explicit ZIndexed(lif::Entity& owner, int z)
 		: lif::Component(owner)
@@ -15,7 +17,17 @@ public:
 	}
 
 	virtual int getZIndex() const { return zIndex; }
-	virtual void setZIndex(int z) { zIndex = z; }
+	virtual void setZIndex(int z) {
+		zIndex = z;
+		if (onChange)
+			onChange();
+	}
+
+	/** Sets a function to call whenever the z-index changes (used by EntityGroup to keep its draw list sorted) */
+	template<typename T>
+	void setOnChange(const T& handler) {
+		onChange = handler;
+	}
 };
 
 }
@@ -4,6 +4,7 @@
 #include "Time.hpp"
 #include <chrono>
 #include <cstring>
+#include <fstream>
 #ifndef RELEASE
 #	include "DebugPainter.hpp"
 #	include "FadeoutTextManager.hpp"
@@ -112,5 +113,11 @@ bool lif::initCore() {
 	ss << pwd << DIRSEP << "saves" << DIRSEP;
 	saveDir = ss.str();
 
+	// If the assets were packed (see AssetArchive), load them from the archive
+	ss.str("");
+	ss << pwd << DIRSEP << ASSET_ARCHIVE_NAME;
+	if (std::ifstream(ss.str()).good())
+		cache.openArchive(ss.str(), assetDir);
+
 	return true;
 }
@@ -38,6 +38,9 @@ constexpr int TILE_SIZE = 64; // pixels
 constexpr auto PI = 3.141592653589793238L;
 constexpr size_t PWD_BUFSIZE = 512;
 
+/** The packed assets, if present in the executable directory (see AssetArchive) */
+constexpr const char *ASSET_ARCHIVE_NAME = "assets.pak";
+
 /** Threshold value to consider an input from joystick getAxisPosition(). */
 constexpr auto JOYSTICK_INPUT_THRESHOLD = 50;
 
@@ -98,22 +101,30 @@ constexpr const std::string& getSaveDir() {
 	return saveDir;
 }
 
-inline void _getAssetInternal(std::stringstream&) {}
+inline std::size_t _getAssetLength() { return 0; }
+
+template<typename... Args>
+inline std::size_t _getAssetLength(const std::string& first, Args&&... rest) {
+	return first.length() + 1 + _getAssetLength(rest...);
+}
+
+inline void _getAssetInternal(std::string&) {}
 
 template<typename... Args>
-inline void _getAssetInternal(std::stringstream& ss, const std::string& first, Args&&... rest) {
-	ss << first << DIRSEP;
-	_getAssetInternal(ss, rest...);
+inline void _getAssetInternal(std::string& s, const std::string& first, Args&&... rest) {
+	s += first;
+	s += DIRSEP;
+	_getAssetInternal(s, rest...);
 }
 
 /** Returns the asset found under assetDir/{path args joined by DIRSEP} */
 template<typename ...Args>
 inline std::string getAsset(Args&&... path) {
-	std::stringstream ss;
-	ss << getAssetDir();
-	_getAssetInternal(ss, path...);
-	auto s = ss.str();
-	s.resize(s.length() - 1);
+	std::string s;
+	s.reserve(getAssetDir().length() + _getAssetLength(path...));
+	s += getAssetDir();
+	_getAssetInternal(s, path...);
+	s.pop_back();
 	return s;
 }
 
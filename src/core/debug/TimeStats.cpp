@@ -4,47 +4,67 @@
 
 using lif::debug::TimeStats;
 
-clock_t TimeStats::start(const std::string& name) {
-	return timers[name] = clock();
+TimeStats::Timer* TimeStats::_find(lif::StringId name) {
+	for (auto& timer : timers)
+		if (timer.name == name)
+			return &timer;
+	return nullptr;
 }
 
-double TimeStats::end(const std::string& name) {
-	auto it = timers.find(name);
-	if (it == timers.end())
-		throw std::logic_error(name + ": end() called without start()!");
+const TimeStats::Timer* TimeStats::_find(lif::StringId name) const {
+	return const_cast<TimeStats*>(this)->_find(name);
+}
+
+TimeStats::Timer& TimeStats::_findOrAdd(lif::StringId name) {
+	if (auto timer = _find(name))
+		return *timer;
+	timers.emplace_back();
+	timers.back().name = name;
+	return timers.back();
+}
 
-	return results[name] = double(clock() - it->second) / CLOCKS_PER_SEC;
+void TimeStats::start(lif::StringId name) {
+	auto& timer = _findOrAdd(name);
+	timer.start = lif::debug::Tracer::now();
+	timer.running = true;
 }
 
-double TimeStats::get(const std::string& name) const {
-	{
-		// Check if a result was already saved for this timer
-		auto it = results.find(name);
-		if (it != results.end())
-			return it->second;
-	}
+double TimeStats::end(lif::StringId name) {
+	auto timer = _find(name);
+	if (timer == nullptr || !timer->running)
+		throw std::logic_error(lif::debug::Tracer::getName(name) + ": end() called without start()!");
+
+	const auto now = lif::debug::Tracer::now();
+	lif::debug::Tracer::record(name, timer->start, now);
+	timer->running = false;
+	timer->hasResult = true;
+	return timer->result = (now - timer->start) * 1e-9;
+}
 
-	// Else, this timer is still running: return snapshot
-	auto it = timers.find(name);
-	if (it == timers.end())
-		throw std::logic_error(name + ": get() called without start()!");
+double TimeStats::get(lif::StringId name) const {
+	const auto timer = _find(name);
+	if (timer == nullptr || !(timer->hasResult || timer->running))
+		throw std::logic_error(lif::debug::Tracer::getName(name) + ": get() called without start()!");
 
-	return double(clock() - it->second) / CLOCKS_PER_SEC;
+	// If a result was already saved for this timer, return it; else it's still running: return snapshot
+	if (timer->hasResult)
+		return timer->result;
+	return (lif::debug::Tracer::now() - timer->start) * 1e-9;
 }
 
-double TimeStats::safeGet(const std::string& name) const {
-	try {
-		return get(name);
-	} catch (const std::exception&) {
+double TimeStats::safeGet(lif::StringId name) const {
+	const auto timer = _find(name);
+	if (timer == nullptr || !(timer->hasResult || timer->running))
 		return -1;
-	}
+	return get(name);
 }
 
-void TimeStats::set(const std::string& name, double amt) {
-	results[name] = amt;
+void TimeStats::set(lif::StringId name, double amt) {
+	auto& timer = _findOrAdd(name);
+	timer.result = amt;
+	timer.hasResult = true;
 }
 
 void TimeStats::flush() {
 	timers.clear();
-	results.clear();
 }
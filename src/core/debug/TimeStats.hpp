@@ -1,8 +1,9 @@
 #pragma once
 
-#include <string>
-#include <map>
-#include <ctime>
+#include "Tracer.hpp"
+#include "sid.hpp"
+#include <cstdint>
+#include <vector>
 
 namespace lif {
 
@@ -10,32 +11,43 @@ namespace debug {
 
 /**
  * Contains time statistics for performance analysis.
+ * Timers are identified by the StringId of their name (see LIF_ZONE_ID), and each one
+ * which is ended is also recorded as a zone by the Tracer.
  * All returned values are in seconds.
  */
 class TimeStats final {
-	/** Contains the starting points in ticks */
-	std::map<std::string, clock_t> timers;
-	/** Contains the results stored by calling `end` */
-	std::map<std::string, double> results;
+	struct Timer {
+		lif::StringId name;
+		/** The Tracer::now() of the last `start` */
+		std::uint64_t start = 0;
+		double result = 0;
+		bool running = false;
+		bool hasResult = false;
+	};
+	/** There are only a handful of timers, so a linear search is the fastest lookup */
+	std::vector<Timer> timers;
+
+	Timer* _find(lif::StringId name);
+	const Timer* _find(lif::StringId name) const;
+	Timer& _findOrAdd(lif::StringId name);
 
 public:
-	/** Sets the starting time for timer `timerName`. Resets previous, if present.
-	 *  @return the saved tick.
-	 */
-	clock_t start(const std::string& timerName);
-	/** Sets the ending time for `timerName` and collects (end-start).
+	/** Sets the starting time for timer `name`. Resets previous, if present. */
+	void start(lif::StringId name);
+	/** Sets the ending time for `name`, collects (end-start) and records it into the Tracer.
 	 *  @return the result in seconds.
 	 */
-	double end(const std::string& timerName);
-	/** Retreives the result of `timerName` in seconds.
+	double end(lif::StringId name);
+	/** Retreives the result of `name` in seconds.
 	 *  If `end()` wasn't called yet, returns (cur_time - start).
 	 *  If `start()` wasn't called either, throws.
 	 */
-	double get(const std::string& timerName) const;
+	double get(lif::StringId name) const;
 	/** Like `get()`, but returns -1 instead of throwing. */
-	double safeGet(const std::string& timerName) const;
-	/** Manually sets results of `timerName` to `amt`. */
-	void set(const std::string& timerName, double amt);
+	double safeGet(lif::StringId name) const;
+	double safeGet(const char *name) const { return safeGet(lif::hashing::fnv1_hash(name)); }
+	/** Manually sets results of `name` to `amt`. */
+	void set(lif::StringId name, double amt);
 	/** Resets all timers and results */
 	void flush();
 };
@@ -0,0 +1,112 @@
+#include "Tracer.hpp"
+#include "json.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using lif::debug::Tracer;
+
+constexpr std::size_t Tracer::BUFFER_SIZE;
+
+namespace {
+
+struct Event {
+	lif::StringId name;
+	std::uint64_t start;
+	std::uint64_t end;
+};
+
+struct ThreadBuffer {
+	/** The id of the thread in the exported trace */
+	unsigned tid;
+	std::unique_ptr<Event[]> events;
+	/** Number of events ever recorded: the latest ones are in events[(written - k) % BUFFER_SIZE] */
+	std::atomic<std::uint64_t> written { 0 };
+
+	explicit ThreadBuffer(unsigned tid) : tid(tid), events(new Event[Tracer::BUFFER_SIZE]) {}
+};
+
+/** Guards `buffers` and `names`, which are only touched once per thread or zone site */
+std::mutex registryMtx;
+/** The buffers of all the threads which recorded something; they outlive their threads */
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+std::unordered_map<lif::StringId, std::string> names;
+
+thread_local ThreadBuffer *threadBuffer = nullptr;
+
+const auto epoch = std::chrono::steady_clock::now();
+
+ThreadBuffer& getThreadBuffer() {
+	if (threadBuffer == nullptr) {
+		std::lock_guard<std::mutex> lock(registryMtx);
+		buffers.emplace_back(new ThreadBuffer(buffers.size()));
+		threadBuffer = buffers.back().get();
+	}
+	return *threadBuffer;
+}
+
+}
+
+std::uint64_t Tracer::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - epoch).count();
+}
+
+lif::StringId Tracer::intern(const char *name) {
+	const auto id = lif::hashing::fnv1_hash(name);
+	std::lock_guard<std::mutex> lock(registryMtx);
+	names.emplace(id, name);
+	return id;
+}
+
+std::string Tracer::getName(lif::StringId id) {
+	std::lock_guard<std::mutex> lock(registryMtx);
+	const auto it = names.find(id);
+	return it != names.end() ? it->second : lif::to_string(id);
+}
+
+void Tracer::record(lif::StringId name, std::uint64_t start, std::uint64_t end) {
+	auto& buf = getThreadBuffer();
+	const auto n = buf.written.load(std::memory_order_relaxed);
+	auto& evt = buf.events[n % BUFFER_SIZE];
+	evt.name = name;
+	evt.start = start;
+	evt.end = end;
+	buf.written.store(n + 1, std::memory_order_release);
+}
+
+bool Tracer::exportChromeTrace(const std::string& path) {
+	std::ofstream out(path);
+	if (!out)
+		return false;
+
+	std::lock_guard<std::mutex> lock(registryMtx);
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	out << std::fixed << std::setprecision(3);
+	for (const auto& buf : buffers) {
+		const auto written = buf->written.load(std::memory_order_acquire);
+		// Leave some slack for the events the owning thread may be overwriting meanwhile
+		const auto kept = std::min<std::uint64_t>(written, BUFFER_SIZE - BUFFER_SIZE / 16);
+		for (auto i = written - kept; i < written; ++i) {
+			const auto& evt = buf->events[i % BUFFER_SIZE];
+			const auto name = names.find(evt.name);
+			out << (first ? "" : ",")
+				<< "\n{\"name\":" << nlohmann::json(name != names.end()
+						? name->second : lif::to_string(evt.name)).dump()
+				<< ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buf->tid
+				<< ",\"ts\":" << evt.start / 1000.0
+				<< ",\"dur\":" << (evt.end - evt.start) / 1000.0 << "}";
+			first = false;
+		}
+	}
+	out << "\n]}\n";
+
+	return static_cast<bool>(out);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "sid.hpp"
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace lif {
+
+namespace debug {
+
+/**
+ * A low-overhead tracing profiler. Zones (see TraceZone and TimeStats) are recorded as
+ * complete events into a ring buffer per thread, which is only ever written by its own thread,
+ * so recording takes no locks. The latest events of all threads can be exported as Chrome
+ * trace-event JSON (which can be opened with chrome://tracing or Perfetto).
+ * Zone names are interned once (see `intern` and LIF_ZONE_ID), so zones only carry a StringId.
+ */
+class Tracer final {
+public:
+	/** Events kept per thread: older ones are overwritten */
+	static constexpr std::size_t BUFFER_SIZE = 1 << 16;
+
+	/** @return A monotonic, high-resolution timestamp in nanoseconds */
+	static std::uint64_t now();
+
+	/** Registers the zone name `name`. This is thread-safe, unlike lif::sid.
+	 *  @return Its id, i.e. lif::hashing::fnv1_hash(name)
+	 */
+	static lif::StringId intern(const char *name);
+	/** @return The interned name with id `id`, or its number if there's none */
+	static std::string getName(lif::StringId id);
+
+	/** Records zone `name` going from `start` to `end` (as returned by `now`) on the calling thread */
+	static void record(lif::StringId name, std::uint64_t start, std::uint64_t end);
+
+	/** Writes the recorded events of all threads as Chrome trace-event JSON to `path`.
+	 *  Events being recorded by other threads meanwhile may be skipped.
+	 *  @return Whether the trace was written
+	 */
+	static bool exportChromeTrace(const std::string& path);
+};
+
+/** Records a zone from its construction to its destruction */
+class TraceZone final : private sf::NonCopyable {
+	const lif::StringId name;
+	const std::uint64_t start;
+
+public:
+	explicit TraceZone(lif::StringId name) : name(name), start(lif::debug::Tracer::now()) {}
+	~TraceZone() { lif::debug::Tracer::record(name, start, lif::debug::Tracer::now()); }
+};
+
+}
+
+}
+
+/** The id of the zone name `name` (a string literal), which is only interned once per call site */
+#define LIF_ZONE_ID(name) \
+	([] () { static const auto id = lif::debug::Tracer::intern(name); return id; }())
+
+#define LIF_TRACE_CONCAT_(a, b) a##b
+#define LIF_TRACE_CONCAT(a, b) LIF_TRACE_CONCAT_(a, b)
+/** Records a zone named `name` (a string literal) until the end of the enclosing scope */
+#define LIF_TRACE_ZONE(name) \
+	lif::debug::TraceZone LIF_TRACE_CONCAT(_traceZone, __LINE__)(LIF_ZONE_ID(name))
@@ -4,7 +4,6 @@
 #include "Time.hpp"
 #include "core.hpp"
 #include <cmath>
-#include <random>
 
 using lif::CameraShake;
 
@@ -15,8 +14,8 @@ CameraShake::CameraShake(sf::RenderTarget& target,
 			float fadeFactor)
 	: lif::Entity({ 0, 0 })
 	, target(target)
-	, offX(std::uniform_real_distribution<float>(0, 2 * lif::PI)(lif::rng))
-	, offY(std::uniform_real_distribution<float>(0, 2 * lif::PI)(lif::rng))
+	, offX(getRandom().nextFloat(0, 2 * lif::PI))
+	, offY(getRandom().nextFloat(0, 2 * lif::PI))
 	, xAmplitude(xAmplitude)
 	, xFrequency(xFrequency)
 	, yAmplitude(yAmplitude)
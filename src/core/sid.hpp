@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #ifndef RELEASE
@@ -26,6 +27,17 @@ constexpr uint32_t fnv1_hash(const char* buffer) {
 	return result;
 }
 
+/** Like fnv1_hash(const char*), but hashes `len` bytes which may contain NULs */
+inline uint32_t fnv1_hash(const char* buffer, std::size_t len) {
+	constexpr uint32_t fnv_prime32 = 16777619;
+	uint32_t result = 2166136261;
+	for (std::size_t i = 0; i < len; ++i) {
+		result *= fnv_prime32;
+		result ^= static_cast<uint32_t>(buffer[i]);
+	}
+	return result;
+}
+
 }
 
 using StringId = uint32_t;
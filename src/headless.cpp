@@ -0,0 +1,442 @@
+/*!
+ * Lifish headless simulation driver
+ * @copyright 2017, Giacomo Parolini
+ *
+ * Runs the game simulation (LevelManager::update) for a fixed number of ticks at a fixed
+ * time step, without creating any window and without drawing anything, then prints the
+ * collected timings as JSON. Meant to measure simulation performance on machines with
+ * no display (e.g. CI boxes).
+ * The players' input can be recorded into an InputRecording and replayed later, so that the
+ * exact same run can be timed on different builds.
+ *
+ * This game is licensed under the Lifish License, available at
+ * https://silverweed.github.io/lifish-license.txt
+ * or in the LICENSE file in this repository's root directory.
+*/
+#include "CameraShakeRequest.hpp"
+#include "Controllable.hpp"
+#include "GameCache.hpp"
+#include "GlobalDataPipe.hpp"
+#include "InputRecording.hpp"
+#include "Level.hpp"
+#include "LevelManager.hpp"
+#include "LevelSet.hpp"
+#include "MusicManager.hpp"
+#include "Options.hpp"
+#include "Player.hpp"
+#include "Pool.hpp"
+#include "Time.hpp"
+#include "game.hpp"
+#include "json.hpp"
+#ifndef RELEASE
+#	include "Tracer.hpp"
+#endif
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+/** Number of heap allocations made by the whole process so far (see the operator new below) */
+static std::atomic<std::size_t> nAllocs(0);
+
+// Count every heap allocation, so we can report the allocation rate of the simulation.
+// (The array and nothrow variants are implemented by the standard library on top of these.)
+void* operator new(std::size_t size) {
+	nAllocs.fetch_add(1, std::memory_order_relaxed);
+	if (auto p = std::malloc(size > 0 ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+	std::free(p);
+}
+
+enum class InputMode {
+	NONE,
+	RANDOM
+};
+
+struct HeadlessArgs {
+	short startLevel = 1;
+	std::string levelsetName;
+	unsigned ticks = 3600;
+	unsigned tickRate = 60;
+	unsigned threads = 0;
+	int nPlayers = 1;
+	InputMode input = InputMode::RANDOM;
+	unsigned seed = 0;
+	std::string outFile;
+	std::string traceFile;
+	std::string recordFile;
+	std::string replayFile;
+};
+
+/** The phases timed by BaseLevelManager and LevelManager which are reported */
+static const std::vector<const char*> PHASES = { "cd", "logic", "ent_update", "checks", "lmtot" };
+
+static void parseArgs(int argc, char **argv, /* out */ HeadlessArgs& args) {
+	bool args_ended = false;
+	int i = 1;
+	const auto next_num = [argc, argv, &i] (const char *flag) -> long {
+		if (i < argc - 1)
+			return std::atol(argv[++i]);
+		std::cerr << "[ WARNING ] Expected numeral after " << flag << " flag" << std::endl;
+		return -1;
+	};
+	while (i < argc) {
+		if (!args_ended && argv[i][0] == '-') {
+			switch (argv[i][1]) {
+			case '-':
+				args_ended = true;
+				break;
+			case 'l':
+				args.startLevel = std::max(1l, next_num("-l"));
+				break;
+			case 'n':
+				args.ticks = std::max(0l, next_num("-n"));
+				break;
+			case 'r':
+				args.tickRate = std::max(1l, next_num("-r"));
+				break;
+			case 'j':
+				args.threads = std::max(0l, next_num("-j"));
+				break;
+			case 'p':
+				args.nPlayers = std::min(static_cast<long>(lif::MAX_PLAYERS), std::max(0l, next_num("-p")));
+				break;
+			case 's':
+				args.seed = std::max(0l, next_num("-s"));
+				break;
+			case 'i':
+				if (i < argc - 1) {
+					const std::string mode(argv[++i]);
+					args.input = mode == "none" ? InputMode::NONE : InputMode::RANDOM;
+				}
+				break;
+			case 'o':
+				if (i < argc - 1)
+					args.outFile = argv[++i];
+				break;
+			case 't':
+				if (i < argc - 1)
+					args.traceFile = argv[++i];
+				break;
+			case 'R':
+				if (i < argc - 1)
+					args.recordFile = argv[++i];
+				break;
+			case 'P':
+				if (i < argc - 1)
+					args.replayFile = argv[++i];
+				break;
+			default:
+				std::cout << "Usage: " << argv[0]
+				          << " [-l <levelnum>] [-n <ticks>] [-r <ticks/s>] [-j <threads>] [-p <players>]"
+				             " [-i none|random] [-s <seed>] [-o <out.json>] [-t <trace.json>]"
+				             " [-R <out.rec> | -P <in.rec>] [levelset.json]\r\n"
+				          << "\t-l: simulate level <levelnum> (default: 1)\r\n"
+				          << "\t-n: number of ticks to simulate (default: 3600)\r\n"
+				          << "\t-r: simulation rate, i.e. 1/delta of each tick (default: 60)\r\n"
+				          << "\t-j: threads updating the entities (default: 0, i.e. as many as the CPU has)\r\n"
+				          << "\t-p: number of players (default: 1)\r\n"
+				          << "\t-i: player input: `none` or `random` (default: random)\r\n"
+				          << "\t-s: random seed used for the game and the scripted input (default: 0)\r\n"
+				          << "\t-o: write the JSON results to <out.json> rather than stdout\r\n"
+				          << "\t-t: write the latest trace events to <trace.json> (Chrome trace-event format;"
+				             " non-RELEASE builds only)\r\n"
+				          << "\t-R: record the players' input and the final state into <out.rec>\r\n"
+				          << "\t-P: replay the run recorded in <in.rec>, overriding -l, -n, -r, -p, -i and -s,\r\n"
+				          << "\t    and exit with status 2 if its final state differs from the recorded one" << std::endl;
+				std::exit(1);
+			}
+		} else {
+			args.levelsetName = std::string(argv[i]);
+		}
+		++i;
+	}
+}
+
+/** Returns an input script which walks around randomly and drops a bomb every now and then. */
+static lif::Controllable::InputScript randomWalker(unsigned seed) {
+	auto rng = std::make_shared<std::default_random_engine>(seed);
+	auto cmd = std::make_shared<lif::Controllable::Command>();
+	return [rng, cmd] () {
+		std::uniform_int_distribution<int> dist(0, 99);
+		// Keep the same direction for a while, as a human player would
+		if (dist(*rng) < 5)
+			cmd->dir = static_cast<lif::Direction>(dist(*rng) % 5);
+		cmd->bomb = dist(*rng) < 2;
+		return *cmd;
+	};
+}
+
+/** (Re)creates the players and (re)loads the level, like GameContext does on level start.
+ *  If `recording` is not null, the players' input is recorded into it or, if `replaying`,
+ *  taken from it.
+ */
+static void startLevel(lif::LevelManager& lm, const lif::LevelSet& ls, const HeadlessArgs& args, unsigned seed,
+		lif::InputRecording *recording, bool replaying)
+{
+	const bool retrying = lm.getLevel() != nullptr;
+	lm.reset();
+	lm.createNewPlayers(args.nPlayers);
+	for (int i = 0; i < args.nPlayers; ++i) {
+		auto p = lm.getPlayer(i + 1);
+		if (p == nullptr) continue;
+		auto controllable = p->get<lif::Controllable>();
+		if (replaying) {
+			controllable->setScript(recording->replayer(i + 1));
+			continue;
+		}
+		controllable->setScript(args.input == InputMode::NONE
+				? [] () { return lif::Controllable::Command(); }
+				: randomWalker(seed + i));
+		if (recording != nullptr)
+			controllable->setRecorder(recording->recorder(i + 1));
+	}
+	if (retrying)
+		lm.resetLevel();
+	else
+		lm.setLevel(ls, args.startLevel);
+	lm.resume();
+}
+
+struct PhaseStats {
+	double total = 0;
+	double max = 0;
+};
+
+int main(int argc, char **argv) {
+	HeadlessArgs args;
+	parseArgs(argc, argv, args);
+
+	// When replaying, the run's parameters are the recorded ones
+	lif::InputRecording recording;
+	const bool replaying = args.replayFile.length() > 0;
+	if (replaying) {
+		if (!recording.loadFromFile(args.replayFile))
+			return 1;
+		const auto& info = recording.getInfo();
+		args.startLevel = info.startLevel;
+		args.ticks = info.ticks;
+		args.tickRate = std::max(1u, info.tickRate);
+		args.nPlayers = std::min(static_cast<int>(info.nPlayers), lif::MAX_PLAYERS);
+		args.seed = info.seed;
+	}
+	const bool recordInput = replaying || args.recordFile.length() > 0;
+
+	lif::MusicManager mm;
+	lif::musicManager = &mm;
+
+	if (!lif::init()) {
+		std::cerr << "[ FATAL ] Failed to initialize the game!" << std::endl;
+		return 1;
+	}
+	lif::rng.seed(args.seed);
+	lif::cache.setHeadless(true);
+	lif::options.soundsMute = true;
+	lif::options.nPlayers = args.nPlayers;
+	lif::options.updateThreads = args.threads;
+
+	if (args.levelsetName.length() < 1)
+		args.levelsetName = std::string(lif::pwd) + lif::DIRSEP + std::string("levels.json");
+
+	lif::LevelSet ls;
+	if (!ls.loadFromFile(args.levelsetName)) {
+		std::cerr << "[ FATAL ] Failed to load levelset " << args.levelsetName << std::endl;
+		return 1;
+	}
+	if (args.startLevel > ls.getLevelsNum()) {
+		std::cerr << "[ FATAL ] Level " << args.startLevel << " not found in levelset!" << std::endl;
+		return 1;
+	}
+	if (replaying && recording.getInfo().levelsetHash != ls.getSourceHash()) {
+		std::cerr << "[ WARNING ] " << args.replayFile << " was recorded with a different levelset than "
+		          << args.levelsetName << ": the replay will likely diverge" << std::endl;
+	}
+
+	lif::LevelManager lm;
+	startLevel(lm, ls, args, args.seed, recordInput ? &recording : nullptr, replaying);
+
+	const auto delta = sf::microseconds(1'000'000 / args.tickRate);
+	auto& cameraShakeRequests = lif::GlobalDataPipe<lif::CameraShakeRequest>::getInstance();
+
+	std::vector<PhaseStats> phases(PHASES.size());
+	std::vector<double> tickTimes;
+	tickTimes.reserve(args.ticks);
+	unsigned restarts = 0;
+	std::size_t maxEntities = 0;
+	// Narrow-phase checks done by the collision detector
+	double cdChecked = 0;
+	int maxCdChecked = 0;
+	// Heap allocations done by lm.update(), in total and in the second half of the run
+	// (i.e. once pools and buffers are warmed up)
+	std::size_t allocs = 0,
+	            steadyAllocs = 0,
+	            maxAllocs = 0;
+
+	using Clock = std::chrono::steady_clock;
+	const auto start = Clock::now();
+	for (unsigned tick = 0; tick < args.ticks; ++tick) {
+		lif::time.step(delta);
+
+		const auto allocsBefore = nAllocs.load(std::memory_order_relaxed);
+		const auto tickStart = Clock::now();
+		lm.update();
+		tickTimes.emplace_back(std::chrono::duration<double>(Clock::now() - tickStart).count());
+		const auto tickAllocs = nAllocs.load(std::memory_order_relaxed) - allocsBefore;
+		allocs += tickAllocs;
+		if (tick >= args.ticks / 2)
+			steadyAllocs += tickAllocs;
+		maxAllocs = std::max(maxAllocs, tickAllocs);
+
+#ifndef RELEASE
+		const auto& stats = lm.getStats();
+		for (unsigned i = 0; i < PHASES.size(); ++i) {
+			const double t = std::max(0.0, stats.timer.safeGet(PHASES[i]));
+			phases[i].total += t;
+			phases[i].max = std::max(phases[i].max, t);
+		}
+		const int checked = lm.getCollisionDetector().getStats().counter.safeGet("checked");
+		cdChecked += std::max(0, checked);
+		maxCdChecked = std::max(maxCdChecked, checked);
+#endif
+		maxEntities = std::max(maxEntities, lm.getEntities().size());
+
+		// Nobody is going to draw the camera shakes
+		cameraShakeRequests.clear();
+
+		// Keep the simulation going: restart the level when it's over
+		if (lm.isGameOver() || lm.mustRetryLevel()) {
+			startLevel(lm, ls, args, args.seed + ++restarts * lif::MAX_PLAYERS,
+					recordInput ? &recording : nullptr, replaying);
+		}
+	}
+	const double wall = std::chrono::duration<double>(Clock::now() - start).count();
+	const auto stateHash = lif::InputRecording::hashState(lm.getEntities());
+
+	json result;
+	result["levelset"] = args.levelsetName;
+	result["level"] = args.startLevel;
+	result["ticks"] = args.ticks;
+	result["tick_rate"] = args.tickRate;
+	result["threads"] = lm.getJobSystem().getThreadsCount();
+	result["players"] = args.nPlayers;
+	result["input"] = replaying ? "replay" : args.input == InputMode::NONE ? "none" : "random";
+	result["seed"] = args.seed;
+	result["restarts"] = restarts;
+	result["max_entities"] = maxEntities;
+	result["state_hash"] = stateHash;
+	if (replaying) {
+		result["replay"] = {
+			{ "file", args.replayFile },
+			{ "recorded_state_hash", recording.getInfo().stateHash },
+			{ "matches", recording.getInfo().stateHash == stateHash }
+		};
+	}
+	result["wall_s"] = wall;
+	result["ticks_per_s"] = wall > 0 ? args.ticks / wall : 0;
+	if (tickTimes.size() > 0) {
+		double tickTotal = 0;
+		for (auto t : tickTimes)
+			tickTotal += t;
+		std::sort(tickTimes.begin(), tickTimes.end());
+		const auto pct = [&tickTimes] (double p) {
+			return tickTimes[std::min(tickTimes.size() - 1, static_cast<std::size_t>(p * tickTimes.size()))] * 1000;
+		};
+		result["tick_ms"] = {
+			{ "mean", tickTotal / tickTimes.size() * 1000 },
+			{ "p50", pct(0.5) },
+			{ "p99", pct(0.99) },
+			{ "max", tickTimes.back() * 1000 }
+		};
+	}
+	const auto steadyTicks = args.ticks - args.ticks / 2;
+	result["allocs_per_tick"] = {
+		{ "mean", args.ticks > 0 ? static_cast<double>(allocs) / args.ticks : 0 },
+		{ "steady", steadyTicks > 0 ? static_cast<double>(steadyAllocs) / steadyTicks : 0 },
+		{ "max", maxAllocs }
+	};
+	// Blocks served by the entity/component pools over the whole run (see Pool.hpp):
+	// `fresh` ones were taken from the heap (and are included in the allocations above).
+	const auto poolStats = [] (bool typed) {
+		const auto stats = lif::pool::getStats(typed);
+		return json {
+			{ "fresh", stats.fresh },
+			{ "reused", stats.reused },
+			{ "in_use", stats.inUse }
+		};
+	};
+	result["pools"] = {
+		{ "typed", poolStats(true) },
+		{ "size_classes", poolStats(false) }
+	};
+#ifndef RELEASE
+	// Per-phase timings are only collected by non-RELEASE builds (see BaseLevelManager's DBGSTART)
+	json jphases = json::object();
+	for (unsigned i = 0; i < PHASES.size(); ++i) {
+		jphases[PHASES[i]] = {
+			{ "total_ms", phases[i].total * 1000 },
+			{ "mean_ms", args.ticks > 0 ? phases[i].total / args.ticks * 1000 : 0 },
+			{ "max_ms", phases[i].max * 1000 }
+		};
+	}
+	result["phases"] = jphases;
+	result["cd_checked"] = {
+		{ "mean", args.ticks > 0 ? cdChecked / args.ticks : 0 },
+		{ "max", maxCdChecked }
+	};
+#endif
+
+	if (args.outFile.length() > 0) {
+		std::ofstream out(args.outFile);
+		out << result.dump(4) << std::endl;
+	} else {
+		std::cout << result.dump(4) << std::endl;
+	}
+
+	if (args.traceFile.length() > 0) {
+#ifndef RELEASE
+		if (!lif::debug::Tracer::exportChromeTrace(args.traceFile))
+			std::cerr << "[ WARNING ] Failed to write the trace to " << args.traceFile << std::endl;
+#else
+		std::cerr << "[ WARNING ] Tracing is not available in RELEASE builds" << std::endl;
+#endif
+	}
+
+	if (args.recordFile.length() > 0 && !replaying) {
+		auto& info = recording.getInfo();
+		info.seed = args.seed;
+		info.tickRate = args.tickRate;
+		info.ticks = args.ticks;
+		info.startLevel = args.startLevel;
+		info.nPlayers = args.nPlayers;
+		info.levelsetHash = ls.getSourceHash();
+		info.stateHash = stateHash;
+		if (!recording.saveToFile(args.recordFile))
+			return 1;
+	}
+
+	lm.reset();
+	lif::cache.finalize();
+
+	if (replaying && recording.getInfo().stateHash != stateHash) {
+		std::cerr << "[ ERROR ] The replay diverged from " << args.replayFile << std::endl;
+		return 2;
+	}
+
+	return 0;
+}
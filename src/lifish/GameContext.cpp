@@ -39,8 +39,7 @@ GameContext::GameContext(sf::Window& window, const std::string& levelsetName, sh
 #ifndef RELEASE
 	_addHandler<lif::debug::DebugEventHandler>(std::ref(*this));
 #endif
-	gameRenderTex.create(lif::GAME_WIDTH, lif::GAME_HEIGHT);
-	gameRenderTex.setSmooth(true);
+	_updateRenderDownscale();
 	//sidePanelRenderTex.create(lif::SIDE_PANEL_WIDTH, lif::GAME_HEIGHT);
 
 	levelSetGood = ls.loadFromFile(levelsetName);
@@ -94,6 +93,7 @@ void GameContext::setActive(bool b) {
 }
 
 void GameContext::update() {
+	_updateRenderDownscale();
 
 #ifndef RELEASE
 	if (!((debug >> DBG_NO_PAINT_CLEAR) & 1))
@@ -204,7 +204,8 @@ void GameContext::draw(sf::RenderTarget& window, sf::RenderStates states) const
 
 	// Draw both textures to window
 	sf::Sprite gameSprite(gameRenderTex.getTexture());
-	gameSprite.setOrigin(origin);
+	gameSprite.setOrigin(origin / float(renderDownscale));
+	gameSprite.setScale(renderDownscale, renderDownscale);
 	window.draw(gameSprite, states);
 	window.draw(sidePanel, states);
 
@@ -212,6 +213,20 @@ void GameContext::draw(sf::RenderTarget& window, sf::RenderStates states) const
 	//window.draw(sidePanelSprite, states);
 }
 
+void GameContext::_updateRenderDownscale() {
+	const auto downscale = lif::getRenderDownscale(window.getSize());
+	if (downscale == renderDownscale)
+		return;
+	renderDownscale = downscale;
+
+	// Keep drawing in game coordinates, onto fewer pixels
+	gameRenderTex.create(lif::GAME_WIDTH / downscale, lif::GAME_HEIGHT / downscale);
+	gameRenderTex.setSmooth(true);
+	gameRenderTex.setView(sf::View(sf::FloatRect(0, 0, lif::GAME_WIDTH, lif::GAME_HEIGHT)));
+	lm.getRenderer().setRenderDownscale(downscale);
+	lif::cache.setMipmapping(downscale > 1);
+}
+
 void GameContext::_advanceLevel() {
 	const auto *level = lm.getLevel();
 	if (level == nullptr)
@@ -283,11 +298,11 @@ void GameContext::_printCDStats() const {
 	std::stringstream ss;
 	ss << std::setfill(' ') << std::scientific << std::setprecision(2)
 		<< "#checked: " << std::setw(5) << dbgStats.counter.safeGet("checked")
-		<< " | tot: " << std::setw(6) << dbgStats.timer.safeGet("tot") * 1000
-		<< " | tot_narrow: " << std::setw(6) << dbgStats.timer.safeGet("tot_narrow") * 1000
-		<< " | setup: " << std::setw(6) << dbgStats.timer.safeGet("setup") * 1000
+		<< " | tot: " << std::setw(6) << dbgStats.timer.safeGet("cd_tot") * 1000
+		<< " | tot_narrow: " << std::setw(6) << dbgStats.timer.safeGet("cd_tot_narrow") * 1000
+		<< " | setup: " << std::setw(6) << dbgStats.timer.safeGet("cd_setup") * 1000
 		<< " | average: " << std::setw(6)
-			<< dbgStats.timer.safeGet("tot_narrow")/dbgStats.counter.safeGet("checked") * 1000
+			<< dbgStats.timer.safeGet("cd_tot_narrow")/dbgStats.counter.safeGet("checked") * 1000
 		<< " (ms)"
 		<< std::endl;
 	std::cout << ss.str();
@@ -331,7 +346,7 @@ void GameContext::_printGameStats() const {
 		char percentage[21] = {0};
 		const float ratio = getPercentage(dbgStats, "logic", t.str().c_str(), percentage);
 		ss << "\r\n | " << std::left << std::setw(12) << logicName[i] << ": "
-			<< std::setw(7) << dbgStats.timer.safeGet(t.str()) * 1000
+			<< std::setw(7) << dbgStats.timer.safeGet(t.str().c_str()) * 1000
 			<< "ms " << percentage
 			<< (ratio >= 0 ? " " + lif::to_string(static_cast<int>(ratio*100)) + "%" : "");
 	}
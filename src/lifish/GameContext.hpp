@@ -41,6 +41,8 @@ private:
 
 #endif
 	mutable sf::RenderTexture gameRenderTex;
+	/** `gameRenderTex` has 1/renderDownscale the designed resolution (see lif::getRenderDownscale) */
+	unsigned renderDownscale = 0;
 	mutable sf::RenderTexture sidePanelRenderTex;
 
 	const sf::Window& window;
@@ -57,6 +59,8 @@ private:
 	void _initLM(const sf::Window& window, short lvnum);
 	void _advanceLevel();
 	void _resurrectDeadPlayers();
+	/** Resizes `gameRenderTex` (and what depends on it) if the window size calls for another downscale */
+	void _updateRenderDownscale();
 #ifndef RELEASE
 	void _printCDStats() const;
 	void _printGameStats() const;
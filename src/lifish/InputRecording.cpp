@@ -0,0 +1,164 @@
+#include "InputRecording.hpp"
+#include "AxisMoving.hpp"
+#include "EntityGroup.hpp"
+#include "Killable.hpp"
+#include "Lifed.hpp"
+#include "sid.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+using lif::InputRecording;
+
+namespace {
+
+constexpr char MAGIC[8] = { 'L', 'I', 'F', 'R', 'E', 'C', '\0', '\0' };
+constexpr std::uint32_t FORMAT_VERSION = 1;
+constexpr std::uint8_t BOMB_BIT = 8;
+
+struct Header {
+	char magic[8];
+	std::uint32_t version;
+	InputRecording::Info info;
+};
+
+std::uint8_t encode(const lif::Controllable::Command& cmd) {
+	return static_cast<std::uint8_t>(cmd.dir) | (cmd.bomb ? BOMB_BIT : 0);
+}
+
+lif::Controllable::Command decode(std::uint8_t code) {
+	lif::Controllable::Command cmd;
+	const auto dir = code & (BOMB_BIT - 1);
+	cmd.dir = dir <= lif::Direction::NONE ? static_cast<lif::Direction>(dir) : lif::Direction::NONE;
+	cmd.bomb = (code & BOMB_BIT) != 0;
+	return cmd;
+}
+
+template<typename T>
+void put(std::ostream& out, const T& val) {
+	out.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template<typename T>
+bool get(std::istream& in, T& val) {
+	return static_cast<bool>(in.read(reinterpret_cast<char*>(&val), sizeof(T)));
+}
+
+template<typename T>
+void append(std::vector<char>& buf, const T& val) {
+	const auto bytes = reinterpret_cast<const char*>(&val);
+	buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+} // end anonymous namespace
+
+InputRecording::InputRecording() {
+	cursors.fill(0);
+}
+
+lif::Controllable::InputRecorder InputRecording::recorder(int id) {
+	auto& cmds = commands[id - 1];
+	return [&cmds] (const lif::Controllable::Command& cmd) {
+		cmds.emplace_back(encode(cmd));
+	};
+}
+
+lif::Controllable::InputScript InputRecording::replayer(int id) {
+	const auto& cmds = commands[id - 1];
+	auto& cursor = cursors[id - 1];
+	return [&cmds, &cursor] () {
+		return cursor < cmds.size() ? decode(cmds[cursor++]) : lif::Controllable::Command();
+	};
+}
+
+bool InputRecording::hasPendingCommands() const {
+	for (unsigned i = 0; i < commands.size(); ++i)
+		if (cursors[i] < commands[i].size())
+			return true;
+	return false;
+}
+
+bool InputRecording::saveToFile(const std::string& path) const {
+	std::ofstream out(path, std::ios::binary);
+	Header header;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = FORMAT_VERSION;
+	header.info = info;
+	put(out, header);
+
+	// Players usually keep the same command for many ticks in a row, so store the runs
+	for (const auto& cmds : commands) {
+		std::vector<std::pair<std::uint8_t, std::uint16_t>> runs;
+		for (auto cmd : cmds) {
+			if (runs.size() > 0 && runs.back().first == cmd
+					&& runs.back().second < std::numeric_limits<std::uint16_t>::max())
+				++runs.back().second;
+			else
+				runs.emplace_back(cmd, 1);
+		}
+		put(out, static_cast<std::uint32_t>(runs.size()));
+		for (const auto& run : runs) {
+			put(out, run.first);
+			put(out, run.second);
+		}
+	}
+
+	if (!out) {
+		std::cerr << "[InputRecording] Error: couldn't write " << path << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool InputRecording::loadFromFile(const std::string& path) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		std::cerr << "[InputRecording] Error: couldn't read " << path << std::endl;
+		return false;
+	}
+	Header header;
+	if (!get(in, header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+			|| header.version != FORMAT_VERSION)
+	{
+		std::cerr << "[InputRecording] Error: " << path << " is not a valid input recording" << std::endl;
+		return false;
+	}
+	info = header.info;
+
+	for (unsigned i = 0; i < commands.size(); ++i) {
+		auto& cmds = commands[i];
+		cmds.clear();
+		cursors[i] = 0;
+		std::uint32_t nRuns = 0;
+		bool ok = get(in, nRuns);
+		for (std::uint32_t j = 0; j < nRuns && ok; ++j) {
+			std::uint8_t cmd = 0;
+			std::uint16_t length = 0;
+			ok = get(in, cmd) && get(in, length);
+			cmds.insert(cmds.end(), length, cmd);
+		}
+		if (!ok) {
+			std::cerr << "[InputRecording] Error: " << path << " is truncated" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+std::uint32_t InputRecording::hashState(const lif::EntityGroup& entities) {
+	std::vector<char> state;
+	state.reserve(entities.size() * 16);
+	entities.apply([&state] (const lif::Entity& e) {
+		const auto pos = e.getPosition();
+		append(state, pos.x);
+		append(state, pos.y);
+		if (const auto moving = e.get<lif::AxisMoving>())
+			append(state, static_cast<std::uint8_t>(moving->getDirection()));
+		if (const auto lifed = e.get<lif::Lifed>())
+			append(state, lifed->getLife());
+		if (const auto killable = e.get<lif::Killable>())
+			append(state, killable->isKilled());
+	});
+	return lif::hashing::fnv1_hash(state.data(), state.size());
+}
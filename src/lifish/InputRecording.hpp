@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Controllable.hpp"
+#include "game.hpp"
+
+namespace lif {
+
+class EntityGroup;
+
+/**
+ * The players' input of a simulation run, plus what's needed to run it again the same way:
+ * replaying it at the same tick rate, from the same level and with the same seed, gives the
+ * same simulation (see `hashState`).
+ * Each player's input is recorded as the sequence of the Commands read by its Controllable,
+ * i.e. one per tick in which the player was in control. The Controllables must be the only
+ * source of input, and lif::rng must be seeded with `seed` before the level starts.
+ *
+ * File layout (all integers in host byte order):
+ *   Header { char magic[8]; uint32 version; uint32 seed; uint32 tickRate; uint32 ticks;
+ *            uint16 startLevel; uint16 nPlayers; uint32 levelsetHash; uint32 stateHash; }
+ *   Run    { uint8 command; uint16 length; } x nRuns, for each of the MAX_PLAYERS players,
+ *          preceded by its uint32 nRuns
+ * where `command` is the Direction in the lower 3 bits, plus 8 if the bomb was used.
+ */
+class InputRecording final {
+public:
+	struct Info {
+		std::uint32_t seed = 0;
+		std::uint32_t tickRate = 0;
+		/** Duration of the recorded run, in ticks */
+		std::uint32_t ticks = 0;
+		std::uint16_t startLevel = 0;
+		std::uint16_t nPlayers = 0;
+		/** LevelSet::getSourceHash of the levelset used */
+		std::uint32_t levelsetHash = 0;
+		/** hashState of the entities at the end of the run */
+		std::uint32_t stateHash = 0;
+	};
+
+private:
+	Info info;
+	/** Each player's commands, in the order they were read */
+	std::array<std::vector<std::uint8_t>, lif::MAX_PLAYERS> commands;
+	/** The index of the next command to replay for each player */
+	std::array<std::size_t, lif::MAX_PLAYERS> cursors;
+
+public:
+	explicit InputRecording();
+
+	Info& getInfo() { return info; }
+	const Info& getInfo() const { return info; }
+
+	/** @return A recorder which appends the commands it's given to the `id`-th player's ones
+	 *  (`id` starting from 1). Must not outlive this InputRecording.
+	 */
+	lif::Controllable::InputRecorder recorder(int id);
+	/** @return A script returning the `id`-th player's commands in the order they were recorded
+	 *  (`id` starting from 1), then no input at all. Must not outlive this InputRecording.
+	 */
+	lif::Controllable::InputScript replayer(int id);
+	/** @return Whether any of the players has commands left to replay */
+	bool hasPendingCommands() const;
+
+	bool saveToFile(const std::string& path) const;
+	/** Loads the recording from `path`. Errors are reported to stderr.
+	 *  @return Whether the recording was valid
+	 */
+	bool loadFromFile(const std::string& path);
+
+	/** @return An hash of the state of `entities` which is relevant to the simulation (their
+	 *  position, direction and life), telling apart runs which diverged.
+	 */
+	static std::uint32_t hashState(const lif::EntityGroup& entities);
+};
+
+}
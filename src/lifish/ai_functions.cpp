@@ -11,7 +11,6 @@
 #include "game.hpp"
 #include "utils.hpp"
 #include <exception>
-#include <random>
 
 #include <iostream>
 
@@ -42,8 +41,7 @@ AIBoundFunction lif::ai_random(lif::Entity& entity) {
 			if (moving->getDistTravelled() < lif::TILE_SIZE)
 				SAME_DIRECTION
 
-			std::uniform_int_distribution<int> dist(0, 10);
-			if (moving->getDistTravelled() < 2 * lif::TILE_SIZE && dist(lif::rng) <= 4)
+			if (moving->getDistTravelled() < 2 * lif::TILE_SIZE && entity.getRandom().nextInt(0, 10) <= 4)
 				SAME_DIRECTION
 		}
 		D dirs[4];
@@ -59,11 +57,9 @@ AIBoundFunction lif::ai_random(lif::Entity& entity) {
 		if (n < 1) {
 			// If no direction is viable, choose a random one (and basically
 			// just keep on bumping around until a direction is viable)
-			std::uniform_int_distribution<int> d(0, 3);
-			NEW_DIRECTION(directions[d(lif::rng)])
+			NEW_DIRECTION(directions[entity.getRandom().nextInt(0, 3)])
 		} else {
-			std::uniform_int_distribution<int> d(0, n - 1);
-			NEW_DIRECTION(dirs[d(lif::rng)])
+			NEW_DIRECTION(dirs[entity.getRandom().nextInt(0, n - 1)])
 		}
 	};
 }
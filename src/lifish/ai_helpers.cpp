@@ -13,9 +13,8 @@ std::array<lif::Direction, 4> directions = {{
 	D::UP, D::RIGHT, D::DOWN, D::LEFT
 }};
 
-static std::uniform_int_distribution<> rand_dir_dist(0, directions.size());
-lif::Direction randomDirection() {
-	return directions[rand_dir_dist(lif::rng)];
+lif::Direction randomDirection(lif::Random& random) {
+	return directions[random.nextInt(0, directions.size() - 1)];
 }
 
 lif::Direction selectRandomViable(
@@ -31,8 +30,7 @@ lif::Direction selectRandomViable(
 			dirs[n++] = d;
 	if (n == 0)
 		dirs[n++] = opp;
-	std::uniform_int_distribution<int> dist(0, n - 1);
-	return dirs[dist(lif::rng)];
+	return dirs[moving.getOwnerRW().getRandom().nextInt(0, n - 1)];
 }
 
 lif::Direction seeingPlayer(const lif::LevelManager& lm, const lif::AxisSighted& sighted) {
@@ -30,12 +30,14 @@ class AxisSighted;
 class LevelManager;
 class AxisMoving;
 class Entity;
+class Random;
 
 namespace ai {
 
 extern std::array<lif::Direction, 4> directions;
 
-lif::Direction random_direction();
+/** @return One of `directions`, chosen using `random` */
+lif::Direction randomDirection(lif::Random& random);
 
 /** Selects a random direction where `moving` can go, choosing `opp` if
  * and only if no other viable direction is found.
@@ -8,6 +8,7 @@ Bonusable::Bonusable(lif::Entity& owner)
 	: lif::Component(owner)
 {
 	_declComponent<Bonusable>();
+	concurrentUpdate = true;
 	bonusTime.fill(sf::Time::Zero);
 	bonusT.fill(sf::Time::Zero);
 }
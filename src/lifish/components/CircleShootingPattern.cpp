@@ -30,8 +30,7 @@ void CircleShootingPattern::_reset() {
 	shootT = sf::Time::Zero;
 	shotsFired = 0;
 	if (randomizeShootAngle) {
-		std::uniform_real_distribution<double> dist(0, 360);
-		shootAngle = lif::degrees(dist(lif::rng));
+		shootAngle = lif::degrees(getRandom().nextFloat(0, 360));
 	} else {
 		shootAngle = lif::degrees(0);
 	}
@@ -1,5 +1,7 @@
 #include "Controllable.hpp"
 #include "AxisMoving.hpp"
+#include "Time.hpp"
+#include "core.hpp"
 #include "input_utils.hpp"
 #include <exception>
 
@@ -25,21 +27,21 @@ lif::Entity* Controllable::init() {
 
 void Controllable::update() {
 	lif::Component::update();
-	if (window == nullptr)
+	if (window == nullptr && !script)
 		throw std::logic_error("window is null in Controllable::update()!");
 
-	if (disableTime > sf::Time::Zero) {
-		if (disableClock.getElapsedTime() > disableTime)
-			disableTime = sf::Time::Zero;
-		else
-			return;
-	}
+	if (lif::time.getGameTime() < disabledUntil)
+		return;
 
 	auto dir = lif::Direction::NONE;
 
 	usedBomb = false;
 
-	if (window->hasFocus()) {
+	if (script) {
+		const auto cmd = script();
+		dir = cmd.dir;
+		usedBomb = cmd.bomb;
+	} else if (window->hasFocus()) {
 		if (joystickUsed >= 0) {
 			const auto horizontal = sf::Joystick::getAxisPosition(joystickUsed, sf::Joystick::X),
 				   vertical = sf::Joystick::getAxisPosition(joystickUsed, sf::Joystick::Y);
@@ -71,10 +73,21 @@ void Controllable::update() {
 		}
 	}
 
+	if (recorder) {
+		Command cmd;
+		cmd.dir = dir;
+		cmd.bomb = usedBomb;
+		recorder(cmd);
+	}
+
 	if (owner.isAligned())// || dir == lif::oppositeDirection(moving->getDirection()))
 		moving->setDirection(dir);
 }
 
+void Controllable::disableFor(const sf::Time& time) {
+	disabledUntil = lif::time.getGameTime() + time;
+}
+
 bool Controllable::hasQueuedBombCommand() const {
 	return usedBomb;
 }
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <SFML/Window.hpp>
 #include <SFML/System/Time.hpp>
 #include "Component.hpp"
+#include "Direction.hpp"
 #include "controls.hpp"
 
 namespace lif {
@@ -12,7 +14,23 @@ class AxisMoving;
 
 /** Controllable makes an AxisMoving Entity move taking input from the user. */
 class Controllable : public lif::Component {
+public:
+	/** The input given to a Controllable in a single update */
+	struct Command {
+		lif::Direction dir = lif::Direction::NONE;
+		bool bomb = false;
+	};
+	using InputScript = std::function<Command()>;
+	/** Called with the input read in each update, whatever its source */
+	using InputRecorder = std::function<void(const Command&)>;
+
+private:
 	const sf::Window *window = nullptr;
+	/** If set, the input is taken from this function instead of keyboard and joystick,
+	 *  and no window is required.
+	 */
+	InputScript script;
+	InputRecorder recorder;
 	/** Reference to an external array telling us how to map keys to controls */
 	const std::array<sf::Keyboard::Key, lif::controls::CONTROLS_NUM>& controls;
 
@@ -23,8 +41,10 @@ class Controllable : public lif::Component {
 	/** Reference to an external variable containing the button number for the joystick bomb command */
 	unsigned& joystickBombKey;
 
-	sf::Clock disableClock;
-	sf::Time disableTime = sf::Time::Zero;
+	/** Game time until which the input is ignored. This is game time, like everything else
+	 *  in the simulation, so that replaying the same input gives the same result.
+	 */
+	sf::Time disabledUntil = sf::Time::Zero;
 
 	lif::AxisMoving *moving = nullptr;
 
@@ -39,10 +59,14 @@ public:
 	void update() override;
 
 	void setWindow(const sf::Window& w) { window = &w; }
+	/** Makes this Controllable read its input from `s` rather than from the user */
+	void setScript(InputScript s) { script = s; }
+	/** Makes this Controllable pass the input it reads to `r` (see InputRecording) */
+	void setRecorder(InputRecorder r) { recorder = r; }
 
-	bool hasFocus() const { return window != nullptr && window->hasFocus(); }
+	bool hasFocus() const { return script || (window != nullptr && window->hasFocus()); }
 
-	void disableFor(const sf::Time& time) { disableTime = time; disableClock.restart(); }
+	void disableFor(const sf::Time& time);
 
 	bool hasQueuedBombCommand() const;
 };
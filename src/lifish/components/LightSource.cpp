@@ -1,6 +1,5 @@
 #include "LightSource.hpp"
 #include "core.hpp"
-#include <random>
 
 using lif::LightSource;
 
@@ -13,6 +12,7 @@ LightSource::LightSource(lif::Entity& owner, float radius, sf::Color color, floa
 	, flickerLen(flickerLen)
 {
 	_declComponent<LightSource>();
+	concurrentUpdate = true;
 	if (flickerIntensity > 0) {
 		_fillRandomPool(flickerIntensity);
 		for (unsigned i = 0; i < flickerLen; ++i)
@@ -30,22 +30,21 @@ void LightSource::update() {
 }
 
 void LightSource::_fillRandomPool(float flickerAmount) {
-	std::uniform_real_distribution<float> dist(0, 1);
+	auto& random = getRandom();
 	for (unsigned i = 0; i < randomPool.size(); ++i) {
-		randomPool[i] = (1 - flickerAmount) + flickerAmount * dist(lif::rng);
+		randomPool[i] = (1 - flickerAmount) + flickerAmount * random.nextFloat(0, 1);
 	}
 }
 
 float LightSource::_flickerStep() {
 	const unsigned len = smoothing.size();
-	static int j = 0;
 	float sum = 0;
 	for (unsigned i = 1; i < len; ++i) {
 		smoothing[i-1] = smoothing[i];
 		sum += smoothing[i-1];
 	}
-	smoothing[len-1] = randomPool[j];
-	j = (j + 1) % randomPool.size();
+	smoothing[len-1] = randomPool[poolIdx];
+	poolIdx = (poolIdx + 1) % randomPool.size();
 	sum += smoothing[len-1];
 	return sum / len;
 }
@@ -14,6 +14,8 @@ namespace lif {
 class LightSource : public lif::Component {
 	std::array<float, 256> randomPool;
 	std::vector<float> smoothing;
+	/** The next value of randomPool to use */
+	unsigned short poolIdx = 0;
 
 	float radius;
 	sf::Color color;
@@ -61,8 +61,7 @@ void ScatterVsPlayerPattern::_shoot(const sf::Vector2f& target) {
 	// `scatterAngle` and centered towards `playerPos`.
 	const auto playerAngle = _calcAngle(target);
 	const auto halfScatter = scatterAngle.asRadians() / 2;
-	std::uniform_real_distribution<double> scatter(-halfScatter, halfScatter);
 
 	addSpawned(lif::BulletFactory::create(bulletId, owner.getPosition(),
-			playerAngle + lif::radians(scatter(lif::rng)), &owner));
+			playerAngle + lif::radians(getRandom().nextFloat(-halfScatter, halfScatter)), &owner));
 }
@@ -14,6 +14,7 @@
 #include "Options.hpp"
 #include "Player.hpp"
 #include "Time.hpp"
+#include "Tracer.hpp"
 #include "collision_utils.hpp"
 #include "conf/zindex.hpp"
 #include "game.hpp"
@@ -34,6 +35,7 @@ DebugEventHandler::DebugEventHandler(lif::GameContext& game)
 /*
  * B : kill all bosses
  * C : print all entities
+ * E : print cache stats
  * F : print CD stats
  * G : draw colliders
  * H : draw SH cells
@@ -163,6 +165,10 @@ bool DebugEventHandler::handleEvent(sf::Window&, sf::Event event) {
 			}
 			return true;
 
+		case sf::Keyboard::E:
+			lif::options.printCacheStats = !lif::options.printCacheStats;
+			return true;
+
 		case sf::Keyboard::F:
 			game.toggleDebug(lif::GameContext::DBG_PRINT_CD_STATS);
 			return true;
@@ -193,7 +199,9 @@ bool DebugEventHandler::handleEvent(sf::Window&, sf::Event event) {
 
 		case sf::Keyboard::L:
 			if (game.lm.isPaused()) {
-				lif::time.addTime(sf::seconds(1.0 / lif::options.framerateLimit));
+				lif::time.addTime(lif::time.getFixedStep() != sf::Time::Zero
+						? lif::time.getFixedStep()
+						: sf::seconds(1.0 / lif::options.framerateLimit));
 				game.lm.update();
 			} else {
 				game.lm.pause();
@@ -216,6 +224,16 @@ bool DebugEventHandler::handleEvent(sf::Window&, sf::Event event) {
 			});
 			return true;
 
+		case sf::Keyboard::T:
+			{
+				const auto path = std::string(lif::pwd) + lif::DIRSEP + "trace.json";
+				if (lif::debug::Tracer::exportChromeTrace(path))
+					lif::fadeoutTextMgr->add("Trace written to " + path);
+				else
+					std::cerr << "Failed to write the trace to " << path << std::endl;
+			}
+			return true;
+
 		case sf::Keyboard::Slash:
 			if (!shift)
 				return false;
@@ -389,6 +407,7 @@ void _printHelp() {
 	std::cout << "\n====== DEBUG COMMANDS (with US layout): ======\n"
 		<< "B : kill all bosses\n"
 		<< "C : print all entities\n"
+		<< "E : print cache stats\n"
 		<< "F : print CD stats\n"
 		<< "G : draw colliders\n"
 		<< "H : draw SH cells\n"
@@ -399,6 +418,7 @@ void _printHelp() {
 		<< "M : morph all enemies\n"
 		<< "N : kill all enemies\n"
 		<< "Q : quit game\n"
+		<< "T : export the latest trace events to trace.json\n"
 		<< "\\ : print number of entities\n"
 		<< ". : give infinite shield to player\n"
 		<< "+ : forward one level\n"
@@ -35,8 +35,7 @@ AlienPredator::AlienPredator(const sf::Vector2f& pos, const lif::EnemyInfo& info
 	});
 	{
 		// Add an initial random time
-		std::uniform_real_distribution<float> dist(0, TUNNEL_PERIOD.asSeconds());
-		tunnelT = sf::seconds(dist(lif::rng));
+		tunnelT = sf::seconds(getRandom().nextFloat(0, TUNNEL_PERIOD.asSeconds()));
 	}
 	// Add the tunneling animation
 	auto& a_tunnel = animated->addAnimation("tunnel");
@@ -151,9 +150,8 @@ sf::Vector2f AlienPredator::_findTunneledPosition(const lif::LevelManager& lm) c
 	if (tiles.size() == 0)
 		return newPos;
 
-	std::uniform_int_distribution<short> dist(0, tiles.size() - 1);
 	auto it = tiles.begin();
-	std::advance(it, dist(lif::rng));
+	std::advance(it, getRandom().nextInt(0, tiles.size() - 1));
 
 	return sf::Vector2f(static_cast<int>(TILE_SIZE) * *it);
 }
@@ -2,11 +2,12 @@
 
 #include "Bullet.hpp"
 #include "Direction.hpp"
+#include "Pool.hpp"
 
 namespace lif {
 
 /** A Bullet which travels along axes */
-class AxisBullet : public lif::Bullet {
+class AxisBullet : public lif::Bullet, public lif::Pooled<lif::AxisBullet> {
 public:
 	/** Constructs a Bullet with a source Entity (using that Entity's position) */
 	explicit AxisBullet(const sf::Vector2f& pos, lif::Direction dir, const lif::BulletInfo& info,
@@ -24,7 +24,6 @@
 #include "conf/boss.hpp"
 #include "conf/player.hpp"
 #include "game.hpp"
-#include <random>
 #ifndef RELEASE
 	#include "DebugPainter.hpp"
 #endif
@@ -107,9 +106,8 @@ void BigAlienBoss::update() {
 	if (atkT > lif::conf::boss::big_alien_boss::ATK_INTERVAL) {
 		atkT = sf::Time::Zero;
 		moving->block(sf::seconds(1));
-		std::uniform_int_distribution<> dist(1, lif::N_ENEMIES);
 		auto egg = new lif::Egg(position + _eggOffset(),
-				lif::oppositeDirection(moving->getDirection()), lm, dist(lif::rng));
+				lif::oppositeDirection(moving->getDirection()), lm, getRandom().nextInt(1, lif::N_ENEMIES));
 		lif::cache.playSound(egg->get<lif::Sounded>()->getSoundFile("spawn"));
 		spawner->addSpawned(egg);
 	}
@@ -3,6 +3,7 @@
 #include "Entity.hpp"
 #include "conf/bomb.hpp"
 #include <SFML/System.hpp>
+#include "Pool.hpp"
 
 namespace lif {
 
@@ -14,7 +15,7 @@ class Killable;
  * The players' bomb. Upon explosion, a lif::Explosion is spawned
  * where the bomb was deployed.
  */
-class Bomb : public lif::Entity {
+class Bomb : public lif::Entity, public lif::Pooled<lif::Bomb> {
 	sf::Time fuseTime;
 	sf::Time fuseT;
 	unsigned short radius;
@@ -44,12 +44,10 @@ Boss::Boss(const sf::Vector2f& pos)
 		explT = sf::Time::Zero;
 		// Calculate a random location inside the boss
 		const auto bpos = collider->getPosition();
-		std::uniform_real_distribution<float> distX(-0.5 * TILE_SIZE,
-		                                            TILE_SIZE * (collider->getSize().x/TILE_SIZE - 0.5)),
-		                                      distY(-0.5 * TILE_SIZE,
-		                                            TILE_SIZE * (collider->getSize().y/TILE_SIZE - 0.5));
-		const float x = distX(lif::rng),
-		            y = distY(lif::rng);
+		const float x = getRandom().nextFloat(-0.5 * TILE_SIZE,
+		                                      TILE_SIZE * (collider->getSize().x/TILE_SIZE - 0.5)),
+		            y = getRandom().nextFloat(-0.5 * TILE_SIZE,
+		                                      TILE_SIZE * (collider->getSize().y/TILE_SIZE - 0.5));
 		auto expl = new lif::BossExplosion(sf::Vector2f(bpos.x + x, bpos.y + y));
 		lif::cache.playSound(expl->get<lif::Sounded>()->getSoundFile("explode"));
 		return expl;
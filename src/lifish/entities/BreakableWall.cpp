@@ -94,7 +94,7 @@ Animation& BreakableWall::_setupAnimations(const std::string& texture_name) {
 }
 
 lif::Entity* BreakableWall::_spawnBonus() {
-	const auto bonus_type = lif::conf::bonus::distribution(lif::rng);
+	const auto bonus_type = lif::conf::bonus::distribution(getRandom());
 	if (bonus_type < lif::conf::bonus::N_BONUS_TYPES)
 		return new lif::Bonus(position, static_cast<lif::BonusType>(bonus_type));
 
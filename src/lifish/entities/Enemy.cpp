@@ -30,7 +30,6 @@
 #include "conf/enemy.hpp"
 #include "conf/zindex.hpp"
 #include "utils.hpp"
-#include <random>
 #include <sstream>
 
 using lif::Enemy;
@@ -86,7 +85,7 @@ Enemy::Enemy(const sf::Vector2f& pos, unsigned short id, const lif::EnemyInfo& i
 	addComponent<lif::Spawning>(*this, [this] (const lif::Spawning& spw) {
 		return morphed && spw.nSpawned() == 0 && killable->isKilled() && !killable->isKillInProgress();
 	}, [this] () {
-		return new lif::Letter(position, lif::Letter::randomId());
+		return new lif::Letter(position, lif::Letter::randomId(getRandom()));
 	});
 	death = addComponent<lif::RegularEntityDeath>(*this, lif::conf::enemy::DEATH_TIME);
 	shooting = addComponent<lif::Shooting>(*this, info.attack);
@@ -262,10 +261,9 @@ void Enemy::setMorphed(bool b) {
 	}
 }
 
-sf::Time Enemy::getNextYellTime() const {
+sf::Time Enemy::getNextYellTime() {
 	using namespace lif::conf::enemy;
-	static std::uniform_real_distribution<float> d(YELL_INTERVAL_MIN.asSeconds(), YELL_INTERVAL_MAX.asSeconds());
-	return sf::seconds(d(lif::rng));
+	return sf::seconds(getRandom().nextFloat(YELL_INTERVAL_MIN.asSeconds(), YELL_INTERVAL_MAX.asSeconds()));
 }
 
 //////// EnemyDrawableProxy //////////
@@ -275,20 +273,33 @@ lif::EnemyDrawableProxy::EnemyDrawableProxy(const lif::Enemy& e)
 	, morphedAnim(*e.get<lif::AlienSprite>()->get<lif::Animated>())
 {}
 
+const lif::Animated& lif::EnemyDrawableProxy::_getAnimated() const {
+	return enemy.isMorphed() ? morphedAnim : *enemy.animated;
+}
+
+bool lif::EnemyDrawableProxy::_isShieldVisible() const {
+	if (!enemy.bonusable->hasBonus(lif::BonusType::SHIELD))
+		return false;
+	const float s = enemy.bonusable->getElapsedTime(lif::BonusType::SHIELD).asSeconds();
+	const float diff = s - std::floor(s);
+	return enemy.bonusable->getRemainingTime(lif::BonusType::SHIELD) > sf::seconds(3)
+		|| 4 * diff - std::floor(4 * diff) < 0.5;
+}
+
 void lif::EnemyDrawableProxy::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-	const auto& anim = enemy.isMorphed() ? morphedAnim : *enemy.animated;
+	const auto& anim = _getAnimated();
 	target.draw(anim, states);
 
-	if (enemy.bonusable->hasBonus(lif::BonusType::SHIELD)) {
-		const float s = enemy.bonusable->getElapsedTime(lif::BonusType::SHIELD).asSeconds();
-		const float diff = s - std::floor(s);
-		if (enemy.bonusable->getRemainingTime(lif::BonusType::SHIELD) > sf::seconds(3)
-				|| 4 * diff - std::floor(4 * diff) < 0.5)
-		{
-			AnimatedSprite shieldSprite(anim.getSprite());
-			// TODO: scale & offset
-			shieldSprite.setColor(sf::Color(200, 0, 200, 180));
-			target.draw(shieldSprite, states);
-		}
+	if (_isShieldVisible()) {
+		AnimatedSprite shieldSprite(anim.getSprite());
+		// TODO: scale & offset
+		shieldSprite.setColor(sf::Color(200, 0, 200, 180));
+		target.draw(shieldSprite, states);
 	}
 }
+
+const sf::Texture* lif::EnemyDrawableProxy::getBatchQuad(sf::Vertex *quad) const {
+	if (_isShieldVisible())
+		return nullptr;
+	return _getAnimated().getBatchQuad(quad);
+}
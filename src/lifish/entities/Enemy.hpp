@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Attack.hpp"
+#include "Batchable.hpp"
 #include "Entity.hpp"
 #include "game.hpp"
 #include <SFML/System.hpp>
@@ -33,14 +34,19 @@ struct EnemyInfo {
  * This class provides a Drawable proxy to draw the regular enemy's sprite
  * or its AlienSprite according to the morphed state of the Enemy.
  */
-class EnemyDrawableProxy : public sf::Drawable {
+class EnemyDrawableProxy : public sf::Drawable, public lif::Batchable {
 	const lif::Enemy& enemy;
 	const lif::Animated& morphedAnim;
 
+	const lif::Animated& _getAnimated() const;
+	bool _isShieldVisible() const;
+
 public:
 	explicit EnemyDrawableProxy(const lif::Enemy& e);
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+	/** Implements Batchable: this can be batched while not showing the shield */
+	const sf::Texture* getBatchQuad(sf::Vertex *quad) const override;
 };
 
 /**
@@ -58,7 +64,7 @@ class Enemy : public lif::Entity {
 	bool canYell = false;
 	sf::Time yellT;
 
-	sf::Time getNextYellTime() const;
+	sf::Time getNextYellTime();
 	void _setShootAnim();
 
 protected:
@@ -98,7 +98,8 @@ void Explosion::update() {
 Explosion* Explosion::propagate(lif::LevelManager& lm) {
 	const sf::Vector2i m_tile = lif::tile(position);
 	const auto lvinfo = lm.getLevel()->getInfo();
-	auto& entities = lm.getEntities();
+	const auto& occupancy = lm.getOccupancy();
+	const auto blockingLayers = lif::OccupancyGrid::solidFor(lif::c_layers::EXPLOSIONS);
 	std::array<bool, 4> propagating,
 	                    blocked;
 
@@ -135,16 +136,9 @@ Explosion* Explosion::propagate(lif::LevelManager& lm) {
 			++propagation[dir];
 
 			// Check if a solid fixed entity blocks propagation in this direction
-			const auto rect = sf::FloatRect(new_tile.x * TILE_SIZE, new_tile.y * TILE_SIZE,
-					TILE_SIZE, TILE_SIZE);
-			for (const auto entcld : entities.getCollidersIntersecting(rect)) {
-				if (entcld != nullptr && lif::c_layers::solid[entcld->getLayer()][
-						lif::c_layers::EXPLOSIONS])
-				{
-					propagating[dir] = false;
-					blocked[dir] = true;
-					break;
-				}
+			if (occupancy.getLayers(new_tile) & blockingLayers) {
+				propagating[dir] = false;
+				blocked[dir] = true;
 			}
 		}
 	}
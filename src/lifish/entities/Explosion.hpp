@@ -5,6 +5,7 @@
 #include <SFML/Graphics.hpp>
 #include "Entity.hpp"
 #include "collision_layers.hpp"
+#include "Pool.hpp"
 
 namespace lif {
 
@@ -21,7 +22,7 @@ class LightSource;
  * doesn't propagate in time: rather, it blossoms in all involved
  * tiles at once and has a duration of ~200 ms (framerate: 0.05)
  */
-class Explosion : public lif::Entity, public sf::Drawable {
+class Explosion : public lif::Entity, public sf::Drawable, public lif::Pooled<lif::Explosion> {
 
 	/** The tiles involved in this explosion (valid after calling propagate());
 	 *  more specifically, this is a 4-element array containing the propagation
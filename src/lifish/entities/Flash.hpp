@@ -1,13 +1,14 @@
 #pragma once
 
 #include "OneShotFX.hpp"
+#include "Pool.hpp"
 
 namespace lif {
 
 /**
  * The flash made by a Teleport
  */
-class Flash : public lif::OneShotFX {
+class Flash : public lif::OneShotFX, public lif::Pooled<lif::Flash> {
 public:
 	explicit Flash(const sf::Vector2f& pos)
 		: lif::OneShotFX(pos, "flash.png", {
@@ -9,7 +9,6 @@
 #include "game.hpp"
 #include "utils.hpp"
 #include <SFML/System.hpp>
-#include <random>
 
 using lif::Fog;
 
@@ -27,8 +26,7 @@ Fog::Fog(float speed, sf::Time alphaDt)
 	addComponent<lif::ZIndexed>(*this, lif::conf::zindex::FOG);
 
 	// Set a random velocity
-	std::uniform_real_distribution<float> dist(-1, 1);
-	const sf::Vector2f velocity(dist(lif::rng), dist(lif::rng));
+	const sf::Vector2f velocity(getRandom().nextFloat(-1, 1), getRandom().nextFloat(-1, 1));
 	moving = addComponent<lif::FreeMoving>(*this, speed, velocity);
 
 	// Set the initial position
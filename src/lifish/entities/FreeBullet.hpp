@@ -2,11 +2,12 @@
 
 #include "Bullet.hpp"
 #include "Angle.hpp"
+#include "Pool.hpp"
 
 namespace lif {
 
 /** A Bullet which travels along any angle */
-class FreeBullet : public lif::Bullet {
+class FreeBullet : public lif::Bullet, public lif::Pooled<lif::FreeBullet> {
 public:
 	/** Constructs a Bullet with a source Entity (using that Entity's position),
 	 *  traveling at `angle` radians from the vertical axis (CW).
@@ -32,7 +32,6 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <random>
 #include <string>
 #include <vector>
 
@@ -224,8 +223,8 @@ void GodEyeBoss::_shakeWalls() {
 	for (unsigned i = 0; i < LEVEL_CONFIGURATIONS.size(); ++i)
 		if (i != lvConfiguration)
 			possibleConfigs.emplace_back(i);
-	std::uniform_int_distribution<> newLevelConfigDist(0, possibleConfigs.size() - 1);
-	lvConfiguration = static_cast<LevelConfiguration>(possibleConfigs[newLevelConfigDist(lif::rng)]);
+	lvConfiguration = static_cast<LevelConfiguration>(
+			possibleConfigs[getRandom().nextInt(0, possibleConfigs.size() - 1)]);
 
 	assert(0 <= lvConfiguration && "Invalid new configuration!");
 
@@ -276,7 +275,7 @@ void GodEyeBoss::_shakeWalls() {
 #undef MOVE_AND_POP
 
 	// Remove more and more torches as the fight proceeds
-	std::random_shuffle(torches2.begin(), torches2.end());
+	std::shuffle(torches2.begin(), torches2.end(), getRandom());
 	auto torchesToRemove = timesHurt;
 	for (auto torch : torches2) {
 		if (torchesToRemove > 0) {
@@ -153,7 +153,7 @@ StateFunction HauntingSpiritBoss::_updateSelectNewStatue() {
 	if (statues.size() == 0) {
 		return BIND(_updateDying);
 	}
-	std::shuffle(statues.begin(), statues.end(), lif::rng);
+	std::shuffle(statues.begin(), statues.end(), getRandom());
 	// Among the shuffled statues, try to select one in the opposite row than the current.
 	for (auto it = statues.begin(); it != statues.end(); ++it) {
 		assert(!it->expired());
@@ -234,8 +234,7 @@ StateFunction HauntingSpiritBoss::_updateHaunting() {
 		// (the pattern is selected now so we can change the spirit's color)
 		selectedNewPattern = true;
 		showedAtkCue = false;
-		std::uniform_int_distribution<unsigned> dist(0, shootPatterns.size() - 1);
-		curShootIdx = dist(lif::rng);
+		curShootIdx = getRandom().nextInt(0, shootPatterns.size() - 1);
 		curShootPattern = shootPatterns[curShootIdx];
 		statue.setSpiritColor(shootColors[curShootIdx]);
 	}
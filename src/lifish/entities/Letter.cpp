@@ -13,7 +13,6 @@
 #include "conf/zindex.hpp"
 #include "game.hpp"
 #include "utils.hpp"
-#include <random>
 
 using lif::Letter;
 using lif::TILE_SIZE;
@@ -21,10 +20,8 @@ using lif::conf::player::N_EXTRA_LETTERS;
 
 const sf::Time Letter::TRANSITION_DELAY = sf::milliseconds(3000);
 
-static std::uniform_int_distribution<unsigned short> dist(0, N_EXTRA_LETTERS - 1);
-
-unsigned short Letter::randomId() {
-	return dist(lif::rng);
+unsigned short Letter::randomId(lif::Random& random) {
+	return random.nextInt(0, N_EXTRA_LETTERS - 1);
 }
 
 Letter::Letter(const sf::Vector2f& pos, unsigned short _id)
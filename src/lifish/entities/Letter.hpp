@@ -25,7 +25,7 @@ class Letter : public lif::Entity {
 	bool transitioning = false;
 
 public:
-	static unsigned short randomId();
+	static unsigned short randomId(lif::Random& random);
 
 	explicit Letter(const sf::Vector2f& pos, unsigned short id);
 
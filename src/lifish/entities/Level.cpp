@@ -21,6 +21,11 @@ Level::Level(const lif::LevelSet& _levelSet)
 	, levelSet(_levelSet)
 {}
 
+Level::~Level() {
+	lif::cache.releaseTexture(bgTexture);
+	lif::cache.releaseTexture(borderTexture);
+}
+
 lif::Entity* Level::init() {
 	if (initialized) return this;
 
@@ -41,13 +46,13 @@ void Level::_loadTextures() {
 	std::stringstream ss;
 	ss << "bg" << info.tileIDs.bg << ".png";
 	// Load background texture
-	bgTexture = lif::cache.loadTexture(lif::getAsset("graphics", ss.str()));
+	bgTexture = lif::cache.acquireTexture(lif::getAsset("graphics", ss.str()));
 	bgTexture->setSmooth(true);
 	bgTexture->setRepeated(true);
 	// Load borderTexture
 	ss.str("");
 	ss << "border" << info.tileIDs.border << ".png";
-	borderTexture = lif::cache.loadTexture(lif::getAsset("graphics", ss.str()));
+	borderTexture = lif::cache.acquireTexture(lif::getAsset("graphics", ss.str()));
 	borderTexture->setSmooth(true);
 	_loadTiles();
 }
@@ -76,12 +81,12 @@ EntityType Level::getTile(int left, int top) const {
 	return tiles[top * info.width + left];
 }
 
-bool Level::_setTilemap(const std::string& tilemap) {
+bool Level::_setTilemap(const std::vector<lif::EntityType>& tilemap) {
 	bool player_set[] = { false, false };
 	tiles.reserve(info.width * info.height);
 
-	for (unsigned i = 0; i < tilemap.length() && i < static_cast<unsigned>(info.width * info.height); ++i) {
-		const auto et = lif::entityFromLetter(tilemap[i]);
+	for (unsigned i = 0; i < tilemap.size() && i < static_cast<unsigned>(info.width * info.height); ++i) {
+		const auto et = tilemap[i];
 		switch (et) {
 		case EntityType::UNKNOWN:
 			std::cerr << "Unknown entity type `" << et << "` at tile " << i << std::endl;
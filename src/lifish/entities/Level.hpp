@@ -39,8 +39,8 @@ struct LevelInfo {
 	/** Time before "Hurry Up" (in seconds) */
 	int time = 0;
 
-	/** String representation of the tilemap */
-	std::string tilemap;
+	/** The tilemap, row by row */
+	std::vector<lif::EntityType> tilemap;
 
 	/** Special effects for this level (e.g. Fog) */
 	std::unordered_set<std::string> effects;
@@ -90,10 +90,10 @@ class Level final : public lif::Entity, private sf::NonCopyable {
 	/** Loads the content of bgTiles (bgTexture must already be set) */
 	void _loadTiles();
 
-	/** Given a string representation of the level, sets its static tilemap
+	/** Given the level's tilemap, sets its static tilemap
 	 *  by filling the `entities` vector.
 	 */
-	bool _setTilemap(const std::string& tilemap);
+	bool _setTilemap(const std::vector<lif::EntityType>& tilemap);
 
 public:
 	/** Constructs a level without a specified time and tileset. init() must
@@ -101,6 +101,7 @@ public:
 	 *  this Level belongs to.
 	 */
 	explicit Level(const LevelSet& levelSet);
+	~Level();
 
 	/** Loads the appropriate bgTexture, fills the bgTiles and makes this level
 	 *  usable. Must be called after setting info.
@@ -122,7 +123,7 @@ public:
 	std::string getTilemap() const;
 	std::string getTilemapRaw() const;
 
-	const sf::Drawable& getBackground() const { return bgSprite; }
+	const sf::Sprite& getBackground() const { return bgSprite; }
 	const sf::Drawable& getBorder() const { return borderSprite; }
 
 	bool hasEffect(const std::string& effectName) const {
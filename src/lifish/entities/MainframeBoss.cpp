@@ -25,7 +25,6 @@
 #include "spawn_functions.hpp"
 #include <cassert>
 #include <cstdlib>
-#include <random>
 #ifndef RELEASE
 	#include "DebugPainter.hpp"
 #endif
@@ -39,7 +38,6 @@ using namespace lif::conf::boss::mainframe_boss;
 
 static const sf::Vector2f SIZE(5 * TILE_SIZE, 5 * TILE_SIZE);
 static const sf::Time IDLE_FRAME_TIME = sf::milliseconds(100);
-static std::uniform_real_distribution<float> angleDist(0, 360);
 constexpr auto SHIELD_DIAMETER = 8 * TILE_SIZE;
 
 MainframeBoss::MainframeBoss(const sf::Vector2f& pos, lif::LevelManager& lm)
@@ -118,10 +116,9 @@ StateFunction MainframeBoss::_updateIdle() {
 	if (atkT > IDLE_TIME) {
 		/// Choose attack
 		const auto nEnemies = lm.getEntities().size<lif::Enemy>();
-		std::uniform_int_distribution<> dist(0, static_cast<int>(AttackType::N_ATTACKS) - 1
+		auto atkType = getRandom().nextInt(0, static_cast<int>(AttackType::N_ATTACKS) - 1
 				- (nEnemies > 2) // disable SPAWN_ZAPS if there are too many enemies
 		);
-		auto atkType = dist(lif::rng);
 		atkT = sf::Time::Zero;
 		switch (static_cast<AttackType>(atkType)) {
 		case AttackType::ROTATING_SURGE:
@@ -146,7 +143,7 @@ StateFunction MainframeBoss::_updateSurgeEntering() {
 	animated->setFrameTime("idle", sf::milliseconds(30));
 	animated->setAnimation("idle");
 	animated->getSprite().setColor(sf::Color(255, 200, 0));
-	nextAttackAngle = lif::degrees(angleDist(lif::rng));
+	nextAttackAngle = lif::degrees(getRandom().nextFloat(0, 360));
 	// spawn visual warning of surge
 	spawner->addSpawned(new lif::SurgeWarn(position + SIZE * 0.5f, SURGE_WINDUP_TIME, nextAttackAngle));
 	atkT = sf::Time::Zero;
@@ -196,7 +193,7 @@ StateFunction MainframeBoss::_updateLightningShooting() {
 		return BIND(_updateLightningRecover);
 	}
 	if (atkT > LIGHTNING_SHOOT_DELAY) {
-		const auto angle = lif::degrees(angleDist(lif::rng));
+		const auto angle = lif::degrees(getRandom().nextFloat(0, 360));
 		const auto pos = lif::towards(position + (SIZE - sf::Vector2f(TILE_SIZE, TILE_SIZE)) * 0.5f,
 				angle, 40);
 		spawner->addSpawned(lif::BulletFactory::create(104, pos, angle, this));
@@ -246,17 +243,15 @@ StateFunction MainframeBoss::_updateShieldDamage() {
 	if (sparkT > sf::milliseconds(60)) {
 		sparkT = sf::Time::Zero;
 		auto pos = position + sf::Vector2f(SIZE.x - SHIELD_DIAMETER, SIZE.y - SHIELD_DIAMETER);
-		static std::uniform_real_distribution<float> posDist(0, SHIELD_DIAMETER);
-		pos.x += posDist(lif::rng);
-		pos.y += posDist(lif::rng);
+		pos.x += getRandom().nextFloat(0, SHIELD_DIAMETER);
+		pos.y += getRandom().nextFloat(0, SHIELD_DIAMETER);
 		auto spark = new lif::OneShotFX(pos, "spark.png", {
 			sf::IntRect(0 * 2 * TILE_SIZE, 0, 2 * TILE_SIZE, 2 * TILE_SIZE),
 			sf::IntRect(1 * 2 * TILE_SIZE, 0, 2 * TILE_SIZE, 2 * TILE_SIZE),
 			sf::IntRect(2 * 2 * TILE_SIZE, 0, 2 * TILE_SIZE, 2 * TILE_SIZE),
 			sf::IntRect(3 * 2 * TILE_SIZE, 0, 2 * TILE_SIZE, 2 * TILE_SIZE),
 		});
-		static std::uniform_real_distribution<float> scaleDist(0.2f, 1.2f);
-		const auto scale = scaleDist(lif::rng);
+		const auto scale = getRandom().nextFloat(0.2f, 1.2f);
 		spark->get<lif::Animated>()->getSprite().setScale(scale, scale);
 		spawner->addSpawned(spark);
 	}
@@ -307,14 +302,12 @@ StateFunction MainframeBoss::_updateLasersShooting() {
 		const auto lvinfo = lm.getLevel()->getInfo();
 		const auto nRows = lvinfo.width;
 		const auto nCols = lvinfo.height;
-		const auto orientation = static_cast<lif::TimedLaser::Orientation>(rand() % 2);
+		const auto orientation = static_cast<lif::TimedLaser::Orientation>(getRandom().nextInt(0, 1));
 		int rowCol = 0;
 		if (orientation == lif::TimedLaser::Orientation::HORIZONTAL) {
-			std::uniform_int_distribution<> rowDist(0, nRows);
-			rowCol = rowDist(lif::rng);
+			rowCol = getRandom().nextInt(0, nRows);
 		} else {
-			std::uniform_int_distribution<> colDist(0, nCols);
-			rowCol = colDist(lif::rng);
+			rowCol = getRandom().nextInt(0, nCols);
 		}
 		spawner->addSpawned(new lif::TimedLaser(rowCol, orientation, LASERS_WARN_DURATION, LASERS_DAMAGE,
 			{ lif::c_layers::PLAYERS }));
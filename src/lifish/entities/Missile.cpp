@@ -8,7 +8,6 @@
 #include "Temporary.hpp"
 #include "Time.hpp"
 #include "core.hpp"
-#include <random>
 #include <tuple>
 
 using lif::Missile;
@@ -20,9 +19,8 @@ Missile::Missile(const sf::Vector2f& pos, const sf::Vector2f& target,
 	collider->setActive(false); // collide with nothing, not even level bounds
 
 	// randomize the wave function a bit
-	std::uniform_real_distribution<float> dist(6, 20);
-	const auto ampl = dist(lif::rng) * lif::TILE_SIZE;
-	const auto freq = dist(lif::rng);
+	const auto ampl = getRandom().nextFloat(6, 20) * lif::TILE_SIZE;
+	const auto freq = getRandom().nextFloat(6, 20);
 	const auto wave = [ampl, freq] (auto t) {
 		const auto y = ampl * (t - t * t);
 		const auto x = 0.5 * lif::TILE_SIZE * std::sin(freq * t * lif::PI);
@@ -2,13 +2,14 @@
 
 #include "Entity.hpp"
 #include "ShadedText.hpp"
+#include "Pool.hpp"
 
 namespace lif {
 
 /**
  * A temporary sprite showing a small text rising from a position
  */
-class Points : public lif::Entity {
+class Points : public lif::Entity, public lif::Pooled<lif::Points> {
 	const sf::Vector2f initialPos;
 	lif::ShadedText text;
 
@@ -27,7 +27,6 @@
 #include "conf/enemy.hpp"
 #include <algorithm>
 #include <cassert>
-#include <random>
 
 #define BIND(f) std::bind(&RexBoss:: f, this)
 
@@ -221,8 +220,7 @@ StateFunction RexBoss::_updateStompRecover() {
 }
 
 StateFunction RexBoss::_updateAttackExiting() {
-	static std::uniform_int_distribution<> dist(0, 3);
-	moving->setDirection(lif::ai::directions[dist(lif::rng)]);
+	moving->setDirection(lif::ai::randomDirection(getRandom()));
 	steps = 0;
 	return BIND(_updateWalking);
 }
@@ -339,8 +337,7 @@ StateFunction RexBoss::_updateDying() {
 
 void RexBoss::_shootMissile() {
 	auto pos = position;
-	std::uniform_real_distribution<float> dist(0, SIZE.x - lif::TILE_SIZE * 0.5f);
-	pos.x += dist(lif::rng);
+	pos.x += getRandom().nextFloat(0, SIZE.x - lif::TILE_SIZE * 0.5f);
 	pos.y += lif::TILE_SIZE * 0.5;
 
 	assert(missilesShot < missilesTargets.size() && "Shooting more missiles than missileTargets.size()?!");
@@ -360,12 +357,11 @@ void RexBoss::_calcMissilesPos() {
 	// Then, throw around them
 	const auto nPlayers = missilesTargets.size();
 	int pid = 0;
-	std::uniform_int_distribution<> distance_dist(1, 4);
 	// The directions we can pick from per-player (to avoid throwing 2 missiles in the same direction)
 	std::vector<std::vector<lif::Direction>> remainingDirs;
 	for (unsigned i = 0; i < nPlayers; ++i) {
 		remainingDirs.emplace_back(lif::ai::directions.begin(), lif::ai::directions.end());
-		std::random_shuffle(remainingDirs[i].begin(), remainingDirs[i].end());
+		std::shuffle(remainingDirs[i].begin(), remainingDirs[i].end(), getRandom());
 	}
 
 	while (missilesTargets.size() < N_MISSILES) {
@@ -375,9 +371,9 @@ void RexBoss::_calcMissilesPos() {
 		auto& dirs = remainingDirs[pid];
 		if (dirs.size() == 0) {
 			dirs.assign(lif::ai::directions.begin(), lif::ai::directions.end());
-			std::random_shuffle(dirs.begin(), dirs.end());
+			std::shuffle(dirs.begin(), dirs.end(), getRandom());
 		}
-		pos = lif::towards(pos, dirs.back(), TILE_SIZE * distance_dist(lif::rng));
+		pos = lif::towards(pos, dirs.back(), TILE_SIZE * getRandom().nextInt(1, 4));
 		dirs.pop_back();
 		missilesTargets.emplace_back(pos);
 		pid = (pid + 1) % nPlayers;
@@ -400,8 +396,7 @@ int RexBoss::_checkAttackCondition() const {
 	if (viable.size() == 0)
 		return -1;
 
-	std::uniform_int_distribution<> dist(0, viable.size() - 1);
-	return static_cast<int>(viable[dist(lif::rng)]);
+	return static_cast<int>(viable[getRandom().nextInt(0, viable.size() - 1)]);
 }
 
 void RexBoss::_kill() {
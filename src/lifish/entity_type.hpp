@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <ostream>
 
 namespace lif {
 
-enum class EntityType {
+/** Stored as a byte in compiled levelsets (see LevelSet): changing it requires
+ *  bumping LevelSet's format version.
+ */
+enum class EntityType : std::uint8_t {
 	UNKNOWN,
 	EMPTY,
 	FIXED,
@@ -4,6 +4,7 @@
 #include "conf/player.hpp"
 #include "controls.hpp"
 #include "HighScoreManager.hpp"
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <sstream>
@@ -32,6 +33,16 @@ bool lif::init() {
 	return true;
 }
 
+unsigned lif::getRenderDownscale(const sf::Vector2u& outputSize) {
+	// The window's view keeps the designed ratio, so the smaller side sets the scale
+	const auto scale = std::min(outputSize.x / float(lif::WINDOW_WIDTH),
+			outputSize.y / float(lif::WINDOW_HEIGHT));
+	unsigned downscale = 1;
+	while (downscale < lif::MAX_RENDER_DOWNSCALE && scale * downscale * 2 <= 1)
+		downscale *= 2;
+	return downscale;
+}
+
 std::string lif::gameInfo() {
 	std::stringstream ss;
 	ss << "lifish v." VERSION " rev." COMMIT;
@@ -46,6 +46,9 @@ constexpr auto MAIN_WINDOW_SHIFT = 1 + SIDE_PANEL_WIDTH;
 
 constexpr auto N_ENEMIES = 10;
 
+/** The game can be rendered at 1/1, 1/2 or 1/4 of its designed resolution (see getRenderDownscale) */
+constexpr unsigned MAX_RENDER_DOWNSCALE = 4;
+
 namespace fonts {
 	constexpr auto POINTS          = "pf_tempesta_seven_bold.ttf";
 	constexpr auto INTERLEVEL      = "pf_tempesta_seven_bold.ttf";
@@ -58,6 +61,20 @@ namespace fonts {
 	constexpr auto SCREEN          = "pf_tempesta_seven_bold.ttf";
 }
 
+/** The entities' sprite sheets (in assets/graphics) to pack into the texture atlas.
+ *  Textures used as repeated or smooth must not be listed here, as they can't be batched anyway.
+ */
+constexpr const char* ATLAS_TEXTURES[] = {
+	"enemy1.png", "enemy2.png", "enemy3.png", "enemy4.png", "enemy5.png",
+	"enemy6.png", "enemy7.png", "enemy8.png", "enemy9.png", "enemy10.png",
+	"player1.png", "player2.png", "aliensprite.png", "alien_boss.png",
+	"bomb.png", "flash.png",
+	"breakable.png", "fixed.png", "coin.png", "bonuses.png", "extra_letters.png",
+	"teleport.png", "egg.png",
+	"bullets.png", "bossbullet.png", "fireball.png", "flame.png", "lightbolt.png",
+	"magma.png", "mg_shot.png", "plasma.png", "shot.png",
+};
+
 constexpr auto HURRY_UP_SOUND    = "hurryup.ogg";
 constexpr auto GAME_OVER_SOUND   = "gameover.ogg";
 constexpr auto EXTRA_GAME_SOUND  = "extragame.ogg";
@@ -73,6 +90,12 @@ bool init();
 
 std::string gameInfo();
 
+/** @return By how much (1, 2 or up to MAX_RENDER_DOWNSCALE) the game can be rendered below its
+ *  designed resolution (WINDOW_WIDTH x WINDOW_HEIGHT) without losing detail in a window of
+ *  `outputSize` pixels.
+ */
+unsigned getRenderDownscale(const sf::Vector2u& outputSize);
+
 class HighScoreManager& getHighScoreManager();
 
 
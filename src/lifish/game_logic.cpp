@@ -86,26 +86,26 @@ void lif::game_logic::bombDeployLogic(lif::Entity& e, lif::BaseLevelManager& blm
 
 void lif::game_logic::spawningLogic(lif::Entity& e, lif::BaseLevelManager& blm, EntityList& tbspawned) {
 	auto& lm = static_cast<lif::LevelManager&>(blm);
-	for (auto spawning : e.getAll<lif::Spawning>()) {
-		while (spawning->shouldSpawn()) {
-			auto spawned = spawning->spawn().release();
+	e.forEach<lif::Spawning>([&lm, &tbspawned] (lif::Spawning& spawning) {
+		while (spawning.shouldSpawn()) {
+			auto spawned = spawning.spawn().release();
 			if (spawned != nullptr) {
 				if (auto expl = dynamic_cast<lif::Explosion*>(spawned))
 					expl->propagate(lm);
 				tbspawned.emplace_back(spawned);
 			}
 		}
-	}
+	});
 }
 
 void lif::game_logic::scoredKillablesLogic(lif::Entity& e, lif::BaseLevelManager& blm, EntityList& tbspawned) {
 	auto scored = e.get<lif::Scored>();
-	if (scored == nullptr || scored->hasGivenPoints()) return;
+	if (scored->hasGivenPoints()) return;
 
 	auto& lm = static_cast<lif::LevelManager&>(blm);
 
 	auto klb = e.get<lif::Killable>();
-	if (klb != nullptr && klb->isKilled()) {
+	if (klb->isKilled()) {
 		// Special behaviour for bosses
 		const bool is_boss = dynamic_cast<const lif::Boss*>(&klb->getOwner()) != nullptr;
 		if (is_boss && klb->isKillInProgress()) return;
@@ -167,9 +167,9 @@ void lif::game_logic::bonusGrabLogic(lif::Entity& e, lif::BaseLevelManager& blm,
 	grb->grab();
 }
 
-std::vector<lif::BaseLevelManager::GameLogicFunc> lif::game_logic::functions = {
-	lif::game_logic::bombDeployLogic,
-	lif::game_logic::bonusGrabLogic,
-	lif::game_logic::scoredKillablesLogic,
-	lif::game_logic::spawningLogic
+std::vector<lif::BaseLevelManager::GameLogic> lif::game_logic::functions = {
+	{ lif::game_logic::bombDeployLogic, lif::EntityQuery::of<lif::Controllable>() },
+	{ lif::game_logic::bonusGrabLogic, lif::EntityQuery::of<lif::Grabbable>() },
+	{ lif::game_logic::scoredKillablesLogic, lif::EntityQuery::of<lif::Scored, lif::Killable>() },
+	{ lif::game_logic::spawningLogic, lif::EntityQuery::of<lif::Spawning>() }
 };
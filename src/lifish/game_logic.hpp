@@ -22,7 +22,8 @@ namespace game_logic {
 	/** Trigger bonus effects */
 	DEF_LOGIC(bonusGrabLogic);
 
-	extern std::vector<lif::BaseLevelManager::GameLogicFunc> functions;
+	/** All the rules, each with the components an entity must have to be concerned by it */
+	extern std::vector<lif::BaseLevelManager::GameLogic> functions;
 }
 
 }
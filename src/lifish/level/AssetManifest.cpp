@@ -0,0 +1,29 @@
+#include "AssetManifest.hpp"
+#include "GameCache.hpp"
+#include <algorithm>
+
+using lif::AssetManifest;
+
+static void addUnique(std::vector<std::string>& list, const std::string& name) {
+	if (std::find(list.begin(), list.end(), name) == list.end())
+		list.emplace_back(name);
+}
+
+void AssetManifest::addTexture(const std::string& name) {
+	addUnique(textures, name);
+}
+
+void AssetManifest::addSound(const std::string& name) {
+	addUnique(sounds, name);
+}
+
+void AssetManifest::addMusic(const std::string& name) {
+	addUnique(music, name);
+}
+
+void AssetManifest::prefetch() const {
+	for (const auto& name : textures)
+		lif::cache.requestTexture(name);
+	for (const auto& name : sounds)
+		lif::cache.requestSound(name);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace lif {
+
+/**
+ * The assets needed to play a level (see LevelSet::getAssetManifest), as full paths.
+ */
+struct AssetManifest {
+	std::vector<std::string> textures;
+	std::vector<std::string> sounds;
+	/** Music is streamed from disk while playing, so it's listed here but never prefetched */
+	std::vector<std::string> music;
+
+	/** These add `name` to the respective list, unless it's there already */
+	void addTexture(const std::string& name);
+	void addSound(const std::string& name);
+	void addMusic(const std::string& name);
+
+	/** Starts loading all the textures and sounds into lif::cache in background,
+	 *  so they'll be in memory by the time the level is loaded or played.
+	 */
+	void prefetch() const;
+};
+
+}
@@ -7,6 +7,7 @@
 #include "Killable.hpp"
 #include "Level.hpp"
 #include "LevelManager.hpp"
+#include "LevelSet.hpp"
 #include "Player.hpp"
 #include "SidePanel.hpp"
 #include "Time.hpp"
@@ -72,6 +73,8 @@ void InterlevelContext::setRetryingLevel() {
 
 void InterlevelContext::setAdvancingLevel() {
 	lif::time.resume();
+	// Note: this is also called when the level's post cutscene starts
+	_prefetchLevel(lm.getLevel()->getInfo().levelnum + (retryingLevel ? 0 : 1));
 
 	const bool allPlayersDead = _calcPrompts();
 	if (lm.getLevelTime().getRemainingTime() <= sf::Time::Zero || allPlayersDead) {
@@ -93,6 +96,7 @@ void InterlevelContext::setAdvancingLevel() {
 
 void InterlevelContext::setGettingReady(unsigned short lvnum) {
 	lif::time.resume();
+	_prefetchLevel(lvnum);
 
 	state = State::GETTING_READY;
 	time = sf::Time::Zero;
@@ -426,6 +430,14 @@ void InterlevelContext::draw(sf::RenderTarget& window, sf::RenderStates states)
 	window.draw(sidePanel, states);
 }
 
+void InterlevelContext::_prefetchLevel(unsigned short lvnum) {
+	const auto level = lm.getLevel();
+	if (level == nullptr)
+		return;
+	// Requesting the same level twice is harmless, as the cache skips the assets it already has
+	level->getLevelSet().getAssetManifest(lvnum).prefetch();
+}
+
 void InterlevelContext::_givePoints(int amount) {
 	for (unsigned i = 0; i < lif::MAX_PLAYERS; ++i) {
 		auto player = lm.getPlayer(i + 1);
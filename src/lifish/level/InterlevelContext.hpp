@@ -84,6 +84,8 @@ class InterlevelContext : public lif::WindowContext {
 	bool _handleEventPromptContinue(sf::Event event);
 	bool _handleEventPromptHighscore(sf::Event event);
 	void _updateCursorPosition();
+	/** Starts loading the assets of level `lvnum` in background while this screen is shown */
+	void _prefetchLevel(unsigned short lvnum);
 
 public:
 	explicit InterlevelContext(lif::LevelManager& lm, const lif::SidePanel& sidePanel);
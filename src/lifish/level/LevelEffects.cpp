@@ -10,9 +10,9 @@
 using lif::LevelEffects;
 using lif::TILE_SIZE;
 
-LevelEffects::LevelEffects(const sf::Vector2u& windowSize) {
-	darknessRenderTex.create(windowSize.x, windowSize.y);
-}
+LevelEffects::LevelEffects(const sf::Vector2u& windowSize)
+	: windowSize(windowSize)
+{}
 
 std::set<lif::Entity*> LevelEffects::getEffectEntities(const lif::Level& level) {
 	std::set<lif::Entity*> entities;
@@ -32,7 +32,11 @@ void LevelEffects::blendEffects(const lif::LevelManager& lm, sf::RenderTarget& w
 }
 
 void LevelEffects::_blendDarkness(const lif::LevelManager& lm, sf::RenderTarget& window) const {
-	darknessRenderTex.clear(sf::Color::Black);
+	if (darknessRenderTex == nullptr) {
+		darknessRenderTex = std::make_unique<sf::RenderTexture>();
+		darknessRenderTex->create(windowSize.x, windowSize.y);
+	}
+	darknessRenderTex->clear(sf::Color::Black);
 
 	// Calculate visibility circles for light sources
 	lm.getEntities().apply([this] (const lif::Entity& e) {
@@ -45,7 +49,7 @@ void LevelEffects::_blendDarkness(const lif::LevelManager& lm, sf::RenderTarget&
 			sf::RectangleShape rect(sf::Vector2f(fr.width, fr.height));
 			rect.setPosition(fr.left, fr.top);
 			rect.setFillColor(source->getColor());
-			darknessRenderTex.draw(rect);
+			darknessRenderTex->draw(rect);
 		}
 	});
 
@@ -56,18 +60,18 @@ void LevelEffects::_blendDarkness(const lif::LevelManager& lm, sf::RenderTarget&
 		auto rects = _getVisionRectangles(*player);
 		rects.first.setFillColor(sf::Color(255, 255, 255, 120));
 		rects.second.setFillColor(sf::Color(255, 255, 255, 120));
-		darknessRenderTex.draw(rects.first);
-		darknessRenderTex.draw(rects.second);
+		darknessRenderTex->draw(rects.first);
+		darknessRenderTex->draw(rects.second);
 		sf::RectangleShape halo(sf::Vector2f(3 * TILE_SIZE, 3 * TILE_SIZE));
 		const auto ppos = player->getPosition();
 		halo.setPosition(ppos.x - 2 * TILE_SIZE, ppos.y - 2 * TILE_SIZE);
 		halo.setFillColor(sf::Color(255, 255, 255, 200));
-		darknessRenderTex.draw(halo);
+		darknessRenderTex->draw(halo);
 	}
 
-	darknessRenderTex.display();
+	darknessRenderTex->display();
 
-	sf::Sprite darkSprite(darknessRenderTex.getTexture());
+	sf::Sprite darkSprite(darknessRenderTex->getTexture());
 	darkSprite.setPosition(TILE_SIZE, TILE_SIZE);
 	window.draw(darkSprite, sf::BlendMultiply);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <set>
 #include <tuple>
 #include <vector>
@@ -20,7 +21,11 @@ class LevelManager;
 class LevelEffects : private sf::NonCopyable {
 
 	bool darknessOn = false;
-	mutable sf::RenderTexture darknessRenderTex;
+	const sf::Vector2u windowSize;
+	/** Created lazily on the first blend, so that a LevelManager which is never drawn
+	 *  (e.g. in lifish_headless) doesn't need a graphics context.
+	 */
+	mutable std::unique_ptr<sf::RenderTexture> darknessRenderTex;
 
 
 	/** Adds the "darkness" effect to level managed by `lm`, blending it over `window` */
@@ -17,6 +17,7 @@
 #include "Lifed.hpp"
 #include "Options.hpp"
 #include "Player.hpp"
+#include "Random.hpp"
 #include "SaveManager.hpp"
 #include "Shooting.hpp"
 #include "core.hpp"
@@ -145,10 +146,15 @@ void LevelManager::setLevel(const lif::LevelSet& ls, int lvnum) {
 	level = ls.getLevel(lvnum);
 	const auto lvinfo = level->getInfo();
 	effects.setEffects(lvinfo.effects);
+	// The level's entities draw their random streams from this seed (see Entity::getRandom)
+	lif::seedRandomStreams(lif::rng());
 	lif::LevelLoader::load(*level, *this);
+	renderer.invalidateStaticLayer();
+	// This also builds the collision detector's static buckets from the newly loaded walls
 	cd.setLevelLimit(sf::FloatRect(lif::TILE_SIZE, lif::TILE_SIZE,
 				(lvinfo.width + 1) * lif::TILE_SIZE,
 				(lvinfo.height + 1) * lif::TILE_SIZE));
+	occupancy.setLevelSize(lvinfo.width, lvinfo.height);
 	// Don't trigger EXTRA game if there were no coins in the level
 	if (entities.size<lif::Coin>() == 0)
 		extraGameTriggered = true;
@@ -187,15 +193,7 @@ bool LevelManager::canDeployBomb(const lif::Player& player) const {
 
 bool LevelManager::canDeployBombAt(const sf::Vector2i& tile) const {
 	if (_isBombAt(tile)) return false;
-	for (const auto cld : entities.getCollidersIntersecting(sf::FloatRect(
-			lif::TILE_SIZE * tile.x,
-			lif::TILE_SIZE * tile.y,
-			lif::TILE_SIZE, lif::TILE_SIZE)))
-	{
-		if (cld->getLayer() == lif::c_layers::EXPLOSIONS)
-			return false;
-	}
-	return true;
+	return (occupancy.getLayers(tile) & lif::OccupancyGrid::mask(lif::c_layers::EXPLOSIONS)) == 0;
 }
 
 bool LevelManager::_isBombAt(const sf::Vector2i& tile) const {
@@ -419,18 +417,9 @@ bool LevelManager::canGo(const lif::AxisMoving& am, const lif::Direction dir) co
 	if (collider == nullptr)
 		return true;
 
-	// Check if another collider blocks the way
-	for (const auto cld : entities.getCollidersIntersecting(sf::FloatRect(
-			iposx * TILE_SIZE, iposy * TILE_SIZE, TILE_SIZE, TILE_SIZE)))
-	{
-		if (cld->getOwner().get<lif::Fixed>() == nullptr)
-			continue;
-
-		if (collider->isSolidFor(*cld))
-			return false;
-	}
-
-	return true;
+	// Check if a fixed collider blocks the way
+	return (occupancy.getFixedLayers(sf::Vector2i(iposx, iposy))
+			& lif::OccupancyGrid::solidFor(collider->getLayer())) == 0;
 }
 
 
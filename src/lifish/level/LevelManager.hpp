@@ -140,6 +140,9 @@ public:
 
 	const lif::LevelTime& getLevelTime() const { return *levelTime; }
 
+	lif::LevelRenderer& getRenderer() { return renderer; }
+	const lif::LevelRenderer& getRenderer() const { return renderer; }
+
 	/** @return the game over state. The game is over when all players have 0 life and 0 continues. */
 	bool isGameOver() const { return gameOver; }
 	/** @return whether the current level is clear of enemies (entities marked with 'Foe'). */
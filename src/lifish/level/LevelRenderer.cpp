@@ -1,74 +1,291 @@
 #include "Drawable.hpp"
+#include "Fixed.hpp"
+#include "GameCache.hpp"
+#include "Killable.hpp"
 #include "Level.hpp"
 #include "LevelManager.hpp"
 #include "LevelNumText.hpp"
+#include "Moving.hpp"
 #include "Sprite.hpp"
-#include "ZIndexed.hpp"
-#include <unordered_map>
+#include "Time.hpp"
+#include "conf/zindex.hpp"
+#include "core.hpp"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 using lif::LevelRenderer;
 
+using DrawIt = std::vector<lif::DrawItem>::const_iterator;
+
+/** @return The area covered by the level background */
+static sf::FloatRect backgroundBounds(const lif::Level& level) {
+	const auto& bg = level.getBackground();
+	const auto rect = bg.getTextureRect();
+	return sf::FloatRect(bg.getPosition() - bg.getOrigin(), sf::Vector2f(rect.width, rect.height));
+}
+
 LevelRenderer::LevelRenderer(lif::LevelManager& owner)
 	: owner(owner)
 {}
 
+void LevelRenderer::_drawRange(sf::RenderTarget& target, sf::RenderStates states,
+		DrawIt begin, DrawIt end) const
+{
+	const auto& atlas = lif::cache.getAtlas();
+	const auto alpha = lif::time.getAlpha();
+	sf::Vertex quad[4];
+	for (auto it = begin; it != end; ++it) {
+#ifndef RELEASE
+		if (it->zIndexed && drawSelectiveLayers && layersToDraw.find(it->z) == layersToDraw.end())
+			continue;
+#endif
+		if (!it->drawable->isActive())
+			continue;
+		if (staticLayerUsed && _isBaked(*it))
+			continue;
+
+		// Batches never span different layers
+		if (it != begin && it->z != std::prev(it)->z)
+			_flushBatches(target, states);
+
+		// Interpolate the position between the last two simulation steps
+		sf::Vector2f offset;
+		if (alpha < 1 && it->moving != nullptr && it->moving->isActive())
+			offset = it->moving->getRenderOffset(alpha);
+
+		if (batching) {
+			const auto texture = it->drawable->getBatchQuad(quad);
+			// Atlas pages are neither repeated nor smooth
+			const auto region = texture != nullptr && !texture->isRepeated() && !texture->isSmooth()
+				? atlas.find(texture) : nullptr;
+			if (region != nullptr) {
+				auto& batch = batches[region->page];
+				for (auto& v : quad) {
+					v.position += offset;
+					v.texCoords += region->offset;
+					batch.append(v);
+				}
+				continue;
+			}
+		}
+
+		// Not batchable: draw the pending batches first to keep the drawing order
+		_flushBatches(target, states);
+		if (offset.x == 0 && offset.y == 0) {
+			target.draw(*it->drawable, states);
+		} else {
+			auto st = states;
+			st.transform.translate(offset);
+			target.draw(*it->drawable, st);
+		}
+		++drawCalls;
+	}
+	_flushBatches(target, states);
+}
+
+void LevelRenderer::_flushBatches(sf::RenderTarget& target, sf::RenderStates states) const {
+	const auto& atlas = lif::cache.getAtlas();
+	for (unsigned i = 0; i < batches.size(); ++i) {
+		if (batches[i].getVertexCount() == 0)
+			continue;
+		states.texture = &atlas.getPage(i);
+		target.draw(batches[i], states);
+		batches[i].clear();
+		++drawCalls;
+	}
+}
+
+bool LevelRenderer::_isStatic(const lif::DrawItem& item, sf::FloatRect& bounds) const {
+	if (item.z != lif::conf::zindex::WALLS || !item.drawable->isActive())
+		return false;
+	const auto entity = owner.entities.get(item.entity);
+	if (entity == nullptr || entity->get<lif::Fixed>() == nullptr)
+		return false;
+	// A dying wall is animated
+	const auto killable = entity->get<lif::Killable>();
+	if (killable != nullptr && killable->isKilled())
+		return false;
+	sf::Vertex quad[4];
+	if (item.drawable->getBatchQuad(quad) == nullptr)
+		return false;
+	float left = quad[0].position.x, top = quad[0].position.y,
+	      right = left, bottom = top;
+	for (const auto& v : quad) {
+		left = std::min(left, v.position.x);
+		top = std::min(top, v.position.y);
+		right = std::max(right, v.position.x);
+		bottom = std::max(bottom, v.position.y);
+	}
+	bounds = sf::FloatRect(left, top, right - left, bottom - top);
+	return true;
+}
+
+bool LevelRenderer::_isBaked(const lif::DrawItem& item) const {
+	return item.entity.index < baked.size() && baked[item.entity.index].generation == item.entity.generation;
+}
+
+void LevelRenderer::_unbake(BakedItem& item) const {
+	dirtyRects.emplace_back(item.bounds);
+	item.generation = 0;
+	item.drawable = nullptr;
+	--bakedCount;
+}
+
+void LevelRenderer::_updateStaticLayer(const lif::Level& level, DrawIt begin, DrawIt end) const {
+	++frame;
+	if (!staticLayerValid) {
+		baked.clear();
+		bakedCount = 0;
+		dirtyRects.clear();
+	}
+
+	unsigned seen = 0;
+	for (auto it = begin; it != end; ++it) {
+		const auto idx = it->entity.index;
+		if (idx >= baked.size())
+			baked.resize(idx + 1);
+		auto& item = baked[idx];
+		// The entity this slot was baked for is gone, and its handle was reused
+		if (item.generation != 0 && item.generation != it->entity.generation)
+			_unbake(item);
+
+		const bool wasBaked = item.generation != 0;
+		sf::FloatRect bounds;
+		if (wasBaked) {
+			bounds = item.bounds;
+			// Only the kill state of a baked wall may change
+			const auto killable = owner.entities.get(it->entity)->get<lif::Killable>();
+			if (it->drawable->isActive() && (killable == nullptr || !killable->isKilled())) {
+				item.seenFrame = frame;
+				++seen;
+			} else {
+				_unbake(item);
+			}
+		} else if (_isStatic(*it, bounds)) {
+			item.generation = it->entity.generation;
+			item.drawable = it->drawable;
+			item.bounds = bounds;
+			item.seenFrame = frame;
+			++bakedCount;
+			++seen;
+			dirtyRects.emplace_back(bounds);
+		}
+	}
+
+	// Unbake the walls which left the draw list
+	if (seen < bakedCount) {
+		for (auto& item : baked)
+			if (item.generation != 0 && item.seenFrame != frame)
+				_unbake(item);
+	}
+
+	if (!staticLayerValid) {
+		const auto bounds = backgroundBounds(level);
+		const sf::Vector2u wantedSize(std::ceil(bounds.width / renderDownscale),
+				std::ceil(bounds.height / renderDownscale));
+		if (staticLayer.getSize() != wantedSize)
+			staticLayer.create(wantedSize.x, wantedSize.y);
+		dirtyRects.clear();
+		_redrawStaticRect(level, bounds);
+		staticLayerValid = true;
+	} else if (dirtyRects.size() > 0) {
+		for (const auto& rect : dirtyRects)
+			_redrawStaticRect(level, rect);
+		dirtyRects.clear();
+	} else {
+		return;
+	}
+	staticLayer.display();
+}
+
+void LevelRenderer::setRenderDownscale(unsigned downscale) {
+	if (downscale == renderDownscale)
+		return;
+	renderDownscale = downscale;
+	staticLayerValid = false;
+}
+
+void LevelRenderer::_redrawStaticRect(const lif::Level& level, const sf::FloatRect& rect) const {
+	// Align the rect to whole pixels of the static layer
+	const auto bounds = backgroundBounds(level);
+	const float d = renderDownscale;
+	const auto left = bounds.left + std::floor((rect.left - bounds.left) / d) * d,
+	           top = bounds.top + std::floor((rect.top - bounds.top) / d) * d,
+	           right = bounds.left + std::ceil((rect.left + rect.width - bounds.left) / d) * d,
+	           bottom = bounds.top + std::ceil((rect.top + rect.height - bounds.top) / d) * d;
+	const sf::FloatRect area(left, top, right - left, bottom - top);
+
+	// Restrict drawing to `area` by mapping it onto the matching viewport
+	sf::View view(area);
+	view.setViewport(sf::FloatRect((area.left - bounds.left) / bounds.width, (area.top - bounds.top) / bounds.height,
+				area.width / bounds.width, area.height / bounds.height));
+	staticLayer.setView(view);
+
+	// Overwrite the area with the background, then put back the walls overlapping it
+	staticLayer.draw(level.getBackground(), sf::RenderStates(sf::BlendNone));
+	++drawCalls;
+	for (const auto& item : baked) {
+		if (item.generation == 0 || !item.bounds.intersects(area))
+			continue;
+		staticLayer.draw(*item.drawable);
+		++drawCalls;
+	}
+}
+
 void LevelRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
 	const auto level = owner.getLevel();
 	if (level == nullptr || !level->isInitialized()) return;
 
-	// Draw the level background
-	target.draw(level->getBackground(), states);
+	drawCalls = 0;
+	if (batches.size() != lif::cache.getAtlas().getPagesCount())
+		batches.assign(lif::cache.getAtlas().getPagesCount(), sf::VertexArray(sf::Quads));
 
-	// Draw according to z-index
-	std::unordered_map<int, std::vector<const lif::Drawable*>> toDraw;
-	toDraw.reserve(owner.entities.size());
+	// Draw according to z-index (the draw list is sorted by z)
+	const auto& drawList = owner.entities.getDrawList();
+	const auto byZ = [] (const lif::DrawItem& item, int z) { return item.z < z; };
+	const auto firstNonNeg = std::lower_bound(drawList.begin(), drawList.end(), 0, byZ);
 
-	int minZ = 0, maxZ = 0;
-	owner.entities.apply([
+	// Draw the level background, along with the walls if they're cached.
+	// Nothing below the walls' layer overlaps them, so they can be drawn before it.
+	staticLayerUsed = staticCaching;
 #ifndef RELEASE
-			drawSelectiveLayers = drawSelectiveLayers,
-			layersToDraw = &layersToDraw,
+	staticLayerUsed = staticLayerUsed && !drawSelectiveLayers;
 #endif
-			&toDraw, &minZ, &maxZ] (const lif::Entity& e) {
-		const auto d = e.get<lif::Drawable>();
-		if (d == nullptr)
-			return;
-		const auto zidx = e.get<lif::ZIndexed>();
-#ifndef RELEASE
-		if (zidx && drawSelectiveLayers && layersToDraw->find(zidx->getZIndex()) == layersToDraw->end())
-			return;
-#endif
-		if (zidx != nullptr) {
-			const auto z = zidx->getZIndex();
-			if (z < minZ) minZ = z;
-			if (z > maxZ) maxZ = z;
-			toDraw[z].emplace_back(d);
-		} else {
-			toDraw[0].emplace_back(d);
-		}
-	});
-
-	for (int i = std::max(0, minZ); i <= maxZ; ++i) {
-		const auto it = toDraw.find(i);
-		if (it == toDraw.end()) continue;
-		for (const auto d : it->second)
-			target.draw(*d, states);
+	if (staticLayerUsed) {
+		const auto walls = std::lower_bound(firstNonNeg, drawList.end(), lif::conf::zindex::WALLS, byZ);
+		const auto wallsEnd = std::lower_bound(walls, drawList.end(), lif::conf::zindex::WALLS + 1, byZ);
+		_updateStaticLayer(*level, walls, wallsEnd);
+		const auto bounds = backgroundBounds(*level);
+		sf::Sprite sprite(staticLayer.getTexture());
+		sprite.setPosition(bounds.left, bounds.top);
+		sprite.setScale(renderDownscale, renderDownscale);
+		target.draw(sprite, states);
+	} else {
+		target.draw(level->getBackground(), states);
 	}
+	++drawCalls;
 
+	_drawRange(target, states, firstNonNeg, drawList.end());
 
 	// Draw the level border
 	target.draw(level->getBorder(), states);
+	++drawCalls;
 
-	// Draw entities above border
-	for (int i = std::min(maxZ, -1); i >= minZ; --i) {
-		const auto it = toDraw.find(i);
-		if (it == toDraw.end()) continue;
-		for (const auto d : it->second)
-			target.draw(*d, states);
+	// Draw entities above border, from z = -1 downwards
+	auto end = firstNonNeg;
+	while (end != drawList.begin()) {
+		const auto z = std::prev(end)->z;
+		auto begin = end;
+		while (begin != drawList.begin() && std::prev(begin)->z == z)
+			--begin;
+		_drawRange(target, states, begin, end);
+		end = begin;
 	}
 
 	const auto levelnumtext = level->get<lif::LevelNumText>();
-	if (levelnumtext != nullptr)
+	if (levelnumtext != nullptr) {
 		target.draw(*levelnumtext, states);
+		++drawCalls;
+	}
 }
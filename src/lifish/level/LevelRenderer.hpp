@@ -1,27 +1,106 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
 #ifndef RELEASE
 #	include <unordered_set>
 #endif
 
 namespace lif {
 
+class Drawable;
+class Level;
 class LevelManager;
+struct DrawItem;
 
 class LevelRenderer final : public sf::Drawable {
 	lif::LevelManager& owner;
 
+	/** Whether to batch the sprites whose texture is in the texture atlas */
+	bool batching = true;
+	/** The quads to draw with each atlas page, reused across frames */
+	mutable std::vector<sf::VertexArray> batches;
+	/** Draw calls issued by the latest `draw` */
+	mutable unsigned drawCalls = 0;
+
+	/** A wall baked into the static layer */
+	struct BakedItem {
+		/** Generation of the baked entity's handle (0 if this slot is unused) */
+		std::uint32_t generation = 0;
+		const lif::Drawable *drawable = nullptr;
+		sf::FloatRect bounds;
+		/** The latest frame this item was found in the draw list */
+		unsigned seenFrame = 0;
+	};
+
+	/** Whether to cache the level background and the walls into `staticLayer` (enabled by default) */
+	bool staticCaching = true;
+	/** The level background with all the static walls drawn on it */
+	mutable sf::RenderTexture staticLayer;
+	/** If false, `staticLayer` must be redrawn entirely */
+	mutable bool staticLayerValid = false;
+	/** Whether the latest `draw` used `staticLayer` (so the baked items must not be drawn again) */
+	mutable bool staticLayerUsed = false;
+	/** The baked items, indexed by their entity handle's index */
+	mutable std::vector<BakedItem> baked;
+	mutable unsigned bakedCount = 0;
+	mutable unsigned frame = 0;
+	/** Areas of `staticLayer` to redraw, as some walls were added or removed there */
+	mutable std::vector<sf::FloatRect> dirtyRects;
+	/** `staticLayer` has 1/renderDownscale the resolution of the level */
+	unsigned renderDownscale = 1;
+
 #ifndef RELEASE
 	std::unordered_set<int> layersToDraw;
 	bool drawSelectiveLayers = false;
 #endif
 
+	/** Draws the items in [begin, end), batching the consecutive ones with the same z-index
+	 *  whose texture is in the atlas.
+	 */
+	void _drawRange(sf::RenderTarget& target, sf::RenderStates states,
+			std::vector<lif::DrawItem>::const_iterator begin,
+			std::vector<lif::DrawItem>::const_iterator end) const;
+	/** Draws and empties all the non-empty batches */
+	void _flushBatches(sf::RenderTarget& target, sf::RenderStates states) const;
+
+	/** @return Whether `item` can be baked into the static layer, i.e. it's a living Fixed wall
+	 *  drawn as a plain quad. If so, its bounds are written into `bounds`.
+	 */
+	bool _isStatic(const lif::DrawItem& item, sf::FloatRect& bounds) const;
+	bool _isBaked(const lif::DrawItem& item) const;
+	void _unbake(BakedItem& item) const;
+	/** Bakes or unbakes the walls in [begin, end) and redraws the areas of the static layer
+	 *  that changed since the latest call.
+	 */
+	void _updateStaticLayer(const lif::Level& level, std::vector<lif::DrawItem>::const_iterator begin,
+			std::vector<lif::DrawItem>::const_iterator end) const;
+	/** Redraws the background and the baked walls within `rect` of the static layer */
+	void _redrawStaticRect(const lif::Level& level, const sf::FloatRect& rect) const;
+
 public:
 	explicit LevelRenderer(lif::LevelManager& owner);
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
+	/** Enables or disables sprite batching (enabled by default) */
+	void setBatching(bool b) { batching = b; }
+	bool isBatching() const { return batching; }
+
+	/** Enables or disables caching the static content of the level into a texture (enabled by default) */
+	void setStaticCaching(bool b) { staticCaching = b; }
+	bool isStaticCaching() const { return staticCaching; }
+	/** Makes the next `draw` redraw the whole static layer. Must be called when the level changes. */
+	void invalidateStaticLayer() { staticLayerValid = false; }
+	/** Sets by how much the target `draw` renders to is smaller than the level, so that the static
+	 *  layer doesn't hold more pixels than the target can show (see lif::getRenderDownscale).
+	 */
+	void setRenderDownscale(unsigned downscale);
+
+	/** @return The number of draw calls issued by the latest `draw` */
+	unsigned getDrawCalls() const { return drawCalls; }
+
 #ifndef RELEASE
 	void setDrawSelectiveLayers(bool d) {
 		drawSelectiveLayers = d;
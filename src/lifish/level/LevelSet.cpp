@@ -1,10 +1,17 @@
 #include "LevelSet.hpp"
+#include "entity_type.hpp"
+#include "game.hpp"
 #include "json.hpp"
+#include "sid.hpp"
 #include "utils.hpp"
+#include "conf/bullet.hpp"
+#include <algorithm>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <iostream>
-#include <cstdlib>
+#include <limits>
+#include <stdexcept>
 
 using json = nlohmann::json;
 using lif::LevelSet;
@@ -15,35 +22,138 @@ static constexpr const char* AVAIL_METADATA[] = {
 	"author", "created", "difficulty", "comment", "name"
 };
 
-LevelSet::LevelSet(const std::string& path) {
-	try {
-		loadFromFile(path);
-	} catch (const std::exception& e) {
-		std::cerr << "[ FATAL ] Failed to parse levelset: " << e.what() << "\n";
-		std::exit(1);
+/* Compiled levelset layout (all integers in host byte order, like AssetArchive's):
+ *   Header { char magic[8]; uint32 version; uint32 sourceHash; uint32 sourceSize;
+ *            uint32 nMeta; uint32 nTracks; uint32 nEnemies; uint32 nLevels; }
+ *   Meta   { string key; string value; } x nMeta
+ *   Track  { float loopstart; float looplength; } x nTracks
+ *   Enemy  { uint16 ai; uint16 speed; uint32 attackType; int32 contactDamage; uint32 bulletId;
+ *            float fireRate; int64 blockTime (us); float range; } x nEnemies
+ *   uint32 levelOffset x nLevels (relative to the start of the compiled levelset)
+ *   Level  { int32 time; uint32 track (from 0); int32 width, height;
+ *            int32 tileIDs.bg, tileIDs.border, tileIDs.fixed, tileIDs.breakable;
+ *            uint32 nEffects; string effect x nEffects; string cutscenePre, cutscenePost;
+ *            uint32 nTiles; uint8 EntityType x nTiles } x nLevels
+ * where a string is { uint32 length; char data[length]; }.
+ * `sourceHash` and `sourceSize` identify the JSON it was compiled from.
+ */
+namespace {
+
+constexpr char MAGIC[8] = { 'L', 'I', 'F', 'L', 'V', 'L', '\0', '\0' };
+constexpr std::uint32_t FORMAT_VERSION = 1;
+
+struct Header {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t sourceHash;
+	std::uint32_t sourceSize;
+	std::uint32_t nMeta;
+	std::uint32_t nTracks;
+	std::uint32_t nEnemies;
+	std::uint32_t nLevels;
+};
+
+class Writer {
+	std::vector<char>& out;
+
+public:
+	explicit Writer(std::vector<char>& out) : out(out) {}
+
+	template<typename T>
+	void put(const T& val) {
+		const auto bytes = reinterpret_cast<const char*>(&val);
+		out.insert(out.end(), bytes, bytes + sizeof(T));
 	}
-}
 
-bool LevelSet::loadFromFile(const std::string& path) {
-	{
-		// Check file exists
-		std::ifstream file(path);
-		if (!file.good())
-			return false;
+	void putString(const std::string& str) {
+		put(static_cast<std::uint32_t>(str.length()));
+		out.insert(out.end(), str.begin(), str.end());
+	}
+};
+
+/** Reads back what a Writer wrote. Reading past the end yields zeroes and clears `ok`. */
+class Reader {
+	const std::vector<char>& data;
+	std::size_t pos;
+
+public:
+	bool ok = true;
+
+	Reader(const std::vector<char>& data, std::size_t pos) : data(data), pos(pos) {}
+
+	const char* getBytes(std::size_t len) {
+		if (!ok || pos > data.size() || len > data.size() - pos) {
+			ok = false;
+			return nullptr;
+		}
+		const auto bytes = data.data() + pos;
+		pos += len;
+		return bytes;
 	}
 
-	json levelJSON = json::parse(std::ifstream(path));
+	template<typename T>
+	T get() {
+		T val {};
+		const auto bytes = getBytes(sizeof(T));
+		if (bytes != nullptr)
+			std::memcpy(&val, bytes, sizeof(T));
+		return val;
+	}
 
-	// load metadata
+	std::string getString() {
+		const auto len = get<std::uint32_t>();
+		const auto bytes = getBytes(len);
+		return bytes != nullptr ? std::string(bytes, len) : "";
+	}
+};
+
+bool readFile(const std::string& path, std::vector<char>& out) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.good())
+		return false;
+	out.resize(static_cast<std::size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(out.data(), out.size());
+	return file.good();
+}
+
+/** @return Whether `data` starts with a valid header of a levelset compiled from `source` */
+bool isCompiledFrom(const std::vector<char>& data, const std::vector<char>& source) {
+	Header header;
+	if (data.size() < sizeof(Header))
+		return false;
+	std::memcpy(&header, data.data(), sizeof(Header));
+	return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+		&& header.version == FORMAT_VERSION
+		&& header.sourceSize == source.size()
+		&& header.sourceHash == lif::hashing::fnv1_hash(source.data(), source.size());
+}
+
+/** Compiles the levelset JSON `source` into `out`. Throws if `source` is not a valid levelset. */
+void compileSource(const std::vector<char>& source, std::vector<char>& out) {
+	const json levelJSON = json::parse(source.begin(), source.end());
+
+	Header header = {};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = FORMAT_VERSION;
+	header.sourceHash = lif::hashing::fnv1_hash(source.data(), source.size());
+	header.sourceSize = source.size();
+
+	out.clear();
+	out.resize(sizeof(Header));
+	Writer w(out);
+
+	// metadata
 	for (const auto& key : AVAIL_METADATA) {
-		if (levelJSON.find(key) != levelJSON.end())
-			metadata[key] = levelJSON[(std::string)key].get<std::string>();
+		const auto it = levelJSON.find(key);
+		if (it == levelJSON.end())
+			continue;
+		w.putString(key);
+		w.putString(it->get<std::string>());
+		++header.nMeta;
 	}
-	metadata["path"] = lif::toRelativePath(path);
 
-	// load tracks data
-	const auto& tracksdata = levelJSON["tracks"];
-	unsigned tracknum = 1;
+	// tracks
 	/* trackinfo = {
 	 *	"loop": {
 	 *		"start": float,
@@ -51,23 +161,23 @@ bool LevelSet::loadFromFile(const std::string& path) {
 	 *	}
 	 * }
 	 */
-	for (const auto& trackinfo : tracksdata) {
-		const auto& loop = trackinfo["loop"];
-		const float loopstart = loop["start"];
+	for (const auto& trackinfo : levelJSON.at("tracks")) {
+		const auto& loop = trackinfo.at("loop");
+		const float loopstart = loop.at("start");
 		float looplength = -1;
 		const auto len = loop.find("length");
 		if (len != loop.end()) {
 			looplength = *len;
 		} else {
-			float loopend = loop["end"];
+			float loopend = loop.at("end");
 			looplength = loopend - loopstart;
 		}
-		tracks.emplace_back(getNthTrack(tracknum++, loopstart, looplength));
+		w.put(loopstart);
+		w.put(looplength);
+		++header.nTracks;
 	}
 
-	// load enemies data
-	const auto& enemydata = levelJSON["enemies"];
-	unsigned enemynum = 0;
+	// enemies
 	/* enemyinfo = {
 	 *	"ai": uint,
 	 *	"speed": uint,
@@ -83,66 +193,62 @@ bool LevelSet::loadFromFile(const std::string& path) {
 	 *
 	 * }
 	 */
-	for (const auto& enemyinfo : enemydata) {
-		enemies[enemynum].ai = enemyinfo["ai"];
-		enemies[enemynum].speed = enemyinfo["speed"];
-
-		const auto& atk = enemyinfo["attack"];
-		const auto& atktype = atk["type"];
-
-		enemies[enemynum].attack.type = static_cast<lif::AttackType>(0);
-		for (unsigned i = 0; i < atktype.size(); ++i) {
-			AttackType type;
-			const auto& at = atktype[i].get<std::string>();
-			if (!lif::stringToAttackType(at, type))
-				throw std::invalid_argument(at.c_str());
-
-			enemies[enemynum].attack.type = AttackType(
-					static_cast<unsigned>(enemies[enemynum].attack.type)
-					| static_cast<unsigned>(type));
+	for (const auto& enemyinfo : levelJSON.at("enemies")) {
+		if (header.nEnemies == lif::N_ENEMIES)
+			throw std::invalid_argument("too many enemies");
+
+		const auto& atk = enemyinfo.at("attack");
+		unsigned type = 0;
+		for (const auto& t : atk.at("type")) {
+			lif::AttackType at;
+			const auto& name = t.get<std::string>();
+			if (!lif::stringToAttackType(name, at))
+				throw std::invalid_argument(name.c_str());
+			type |= static_cast<unsigned>(at);
 		}
 
+		lif::Attack attack;
+		attack.bulletId = 0;
 		// Optional fields
 		auto it = atk.find("id");
 		if (it != atk.end())
-			enemies[enemynum].attack.bulletId = it->get<unsigned>();
+			attack.bulletId = it->get<unsigned>();
 
 		it = atk.find("contactDamage");
 		if (it != atk.end())
-			enemies[enemynum].attack.contactDamage = it->get<int>();
+			attack.contactDamage = it->get<int>();
 
 		it = atk.find("fireRate");
 		if (it != atk.end())
-			enemies[enemynum].attack.fireRate = it->get<float>();
+			attack.fireRate = it->get<float>();
 
 		it = atk.find("blockTime");
 		if (it != atk.end())
-			enemies[enemynum].attack.blockTime = sf::milliseconds(it->get<float>());
+			attack.blockTime = sf::milliseconds(it->get<float>());
 
 		// Find range: first search for `range` (in pixels); if not found, search `tileRange`.
 		// If neither is found, set range to -1 (infinite).
-		enemies[enemynum].attack.range = -1;
-		bool range_found = false;
 		it = atk.find("range");
 		if (it != atk.end()) {
-			enemies[enemynum].attack.range = it->get<float>();
-			range_found = true;
-		}
-		if (!range_found) {
+			attack.range = it->get<float>();
+		} else {
 			it = atk.find("tileRange");
-			if (it != atk.end()) {
-				enemies[enemynum].attack.range =
-					static_cast<float>(it->get<int>() * lif::TILE_SIZE);
-			}
+			if (it != atk.end())
+				attack.range = static_cast<float>(it->get<int>() * lif::TILE_SIZE);
 		}
-		++enemynum;
-	}
 
+		w.put(enemyinfo.at("ai").get<std::uint16_t>());
+		w.put(enemyinfo.at("speed").get<std::uint16_t>());
+		w.put(static_cast<std::uint32_t>(type));
+		w.put(static_cast<std::int32_t>(attack.contactDamage));
+		w.put(static_cast<std::uint32_t>(attack.bulletId));
+		w.put(attack.fireRate);
+		w.put(static_cast<std::int64_t>(attack.blockTime.asMicroseconds()));
+		w.put(attack.range);
+		++header.nEnemies;
+	}
 
-	// load levels data
-	const auto& levelsdata = levelJSON["levels"];
-
-	unsigned lvnum = 1;
+	// levels
 	/* lvinfo = {
 	 *	"time": uint,
 	 *	"tilemap": string,
@@ -160,42 +266,201 @@ bool LevelSet::loadFromFile(const std::string& path) {
 	 *	"cutscenePost": string [opt]
 	 * }
 	 */
+	const auto& levelsdata = levelJSON.at("levels");
+	std::vector<char> records;
+	Writer lw(records);
+	std::vector<std::uint32_t> offsets;
+	const std::size_t recordsStart = out.size() + levelsdata.size() * sizeof(std::uint32_t);
 	for (const auto& lvinfo : levelsdata) {
-		LevelInfo info;
-		info.levelnum          = lvnum++;
-		info.time              = lvinfo["time"];
-		info.track             = tracks[lvinfo["music"].get<unsigned short>()-1];
-		info.tilemap           = lvinfo["tilemap"].get<std::string>();
-		info.width             = lvinfo["width"];
-		info.height            = lvinfo["height"];
-		info.tileIDs.border    = lvinfo["tileIDs"]["border"];
-		info.tileIDs.bg        = lvinfo["tileIDs"]["bg"];
-		info.tileIDs.fixed     = lvinfo["tileIDs"]["fixed"];
-		info.tileIDs.breakable = lvinfo["tileIDs"]["breakable"];
-		auto it = lvinfo.find("effects");
-		if (it != lvinfo.end()) {
-			for (const auto& s : *it) {
-				info.effects.insert(s.get<std::string>());
-			}
+		offsets.emplace_back(recordsStart + records.size());
+
+		const auto music = lvinfo.at("music").get<unsigned>();
+		if (music < 1 || music > header.nTracks)
+			throw std::invalid_argument("invalid music " + lif::to_string(music));
+		const auto& tileIDs = lvinfo.at("tileIDs");
+		lw.put(lvinfo.at("time").get<std::int32_t>());
+		lw.put(static_cast<std::uint32_t>(music - 1));
+		lw.put(lvinfo.at("width").get<std::int32_t>());
+		lw.put(lvinfo.at("height").get<std::int32_t>());
+		lw.put(tileIDs.at("bg").get<std::int32_t>());
+		lw.put(tileIDs.at("border").get<std::int32_t>());
+		lw.put(tileIDs.at("fixed").get<std::int32_t>());
+		lw.put(tileIDs.at("breakable").get<std::int32_t>());
+
+		const auto effects = lvinfo.find("effects");
+		lw.put(static_cast<std::uint32_t>(effects != lvinfo.end() ? effects->size() : 0));
+		if (effects != lvinfo.end()) {
+			for (const auto& e : *effects)
+				lw.putString(e.get<std::string>());
 		}
-		it = lvinfo.find("cutscenePre");
-		if (it != lvinfo.end())
-			info.cutscenePre = it->get<std::string>();
+		auto it = lvinfo.find("cutscenePre");
+		lw.putString(it != lvinfo.end() ? it->get<std::string>() : "");
 		it = lvinfo.find("cutscenePost");
-		if (it != lvinfo.end())
-			info.cutscenePost = it->get<std::string>();
-		levels.emplace_back(info);
+		lw.putString(it != lvinfo.end() ? it->get<std::string>() : "");
+
+		// Unknown letters are kept as UNKNOWN and rejected by Level::init(), as before
+		const auto tilemap = lvinfo.at("tilemap").get<std::string>();
+		lw.put(static_cast<std::uint32_t>(tilemap.length()));
+		for (const char c : tilemap)
+			lw.put(lif::entityFromLetter(c));
+		++header.nLevels;
 	}
 
+	for (const auto offset : offsets)
+		w.put(offset);
+	out.insert(out.end(), records.begin(), records.end());
+	if (out.size() > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("the compiled levelset would exceed 4 GiB");
+
+	std::memcpy(out.data(), &header, sizeof(Header));
+}
+
+} // end anonymous namespace
+
+LevelSet::LevelSet(const std::string& path) {
+	loadFromFile(path);
+}
+
+std::string LevelSet::getCachePath(const std::string& jsonPath) {
+	return jsonPath + ".bin";
+}
+
+bool LevelSet::compile(const std::string& jsonPath, const std::string& outPath) {
+	std::vector<char> source, compiled;
+	if (!readFile(jsonPath, source)) {
+		std::cerr << "[LevelSet] Error: couldn't read " << jsonPath << std::endl;
+		return false;
+	}
+	try {
+		compileSource(source, compiled);
+	} catch (const std::exception& e) {
+		std::cerr << "[LevelSet] Error: failed to parse " << jsonPath << ": " << e.what() << std::endl;
+		return false;
+	}
+
+	std::ofstream out(outPath, std::ios::binary);
+	out.write(compiled.data(), compiled.size());
+	if (!out) {
+		std::cerr << "[LevelSet] Error: couldn't write " << outPath << std::endl;
+		return false;
+	}
 	return true;
 }
 
+bool LevelSet::loadFromFile(const std::string& path) {
+	data.clear();
+	levelOffsets.clear();
+	tracks.clear();
+	metadata.clear();
+	sourceHash = 0;
+
+	std::vector<char> source;
+	if (!readFile(path, source))
+		return false;
+
+	const auto cachePath = getCachePath(path);
+	if (!readFile(cachePath, data) || !isCompiledFrom(data, source)) {
+		try {
+			compileSource(source, data);
+		} catch (const std::exception& e) {
+			std::cerr << "[LevelSet] Error: failed to parse " << path << ": " << e.what() << std::endl;
+			data.clear();
+			return false;
+		}
+		// The cache is just an optimization, so failing to write it is fine
+		std::ofstream out(cachePath, std::ios::binary);
+		out.write(data.data(), data.size());
+	}
+
+	if (!_loadTables(path)) {
+		std::cerr << "[LevelSet] Error: " << cachePath << " is corrupted" << std::endl;
+		data.clear();
+		levelOffsets.clear();
+		tracks.clear();
+		metadata.clear();
+		return false;
+	}
+	return true;
+}
+
+bool LevelSet::_loadTables(const std::string& path) {
+	Reader r(data, 0);
+	const auto header = r.get<Header>();
+	sourceHash = header.sourceHash;
+
+	for (unsigned i = 0; i < header.nMeta && r.ok; ++i) {
+		auto key = r.getString();
+		metadata[key] = r.getString();
+	}
+	metadata["path"] = lif::toRelativePath(path);
+
+	for (unsigned i = 0; i < header.nTracks && r.ok; ++i) {
+		const auto loopstart = r.get<float>();
+		const auto looplength = r.get<float>();
+		tracks.emplace_back(lif::getNthTrack(i + 1, loopstart, looplength));
+	}
+
+	if (header.nEnemies > lif::N_ENEMIES)
+		return false;
+	for (unsigned i = 0; i < header.nEnemies && r.ok; ++i) {
+		auto& enemy = enemies[i];
+		enemy.ai = r.get<std::uint16_t>();
+		enemy.speed = r.get<std::uint16_t>();
+		enemy.attack.type = static_cast<lif::AttackType>(r.get<std::uint32_t>());
+		enemy.attack.contactDamage = r.get<std::int32_t>();
+		enemy.attack.bulletId = r.get<std::uint32_t>();
+		enemy.attack.fireRate = r.get<float>();
+		enemy.attack.blockTime = sf::microseconds(r.get<std::int64_t>());
+		enemy.attack.range = r.get<float>();
+	}
+
+	levelOffsets.resize(header.nLevels);
+	for (auto& offset : levelOffsets) {
+		offset = r.get<std::uint32_t>();
+		if (offset >= data.size())
+			return false;
+	}
+
+	return r.ok;
+}
+
+bool LevelSet::_decodeLevel(unsigned num, lif::LevelInfo& info) const {
+	Reader r(data, levelOffsets[num - 1]);
+
+	info.levelnum = num;
+	info.time = r.get<std::int32_t>();
+	const auto track = r.get<std::uint32_t>();
+	if (track >= tracks.size())
+		return false;
+	info.track = tracks[track];
+	info.width = r.get<std::int32_t>();
+	info.height = r.get<std::int32_t>();
+	info.tileIDs.bg = r.get<std::int32_t>();
+	info.tileIDs.border = r.get<std::int32_t>();
+	info.tileIDs.fixed = r.get<std::int32_t>();
+	info.tileIDs.breakable = r.get<std::int32_t>();
+
+	const auto nEffects = r.get<std::uint32_t>();
+	for (unsigned i = 0; i < nEffects && r.ok; ++i)
+		info.effects.insert(r.getString());
+	info.cutscenePre = r.getString();
+	info.cutscenePost = r.getString();
+
+	const auto nTiles = r.get<std::uint32_t>();
+	const auto tiles = r.getBytes(nTiles);
+	if (tiles != nullptr) {
+		info.tilemap.resize(nTiles);
+		std::memcpy(info.tilemap.data(), tiles, nTiles);
+	}
+
+	return r.ok;
+}
+
 std::unique_ptr<Level> LevelSet::getLevel(unsigned num) const {
 	std::unique_ptr<Level> level;
-	if (num > 0 && num <= levels.size()) {
+	if (num > 0 && num <= levelOffsets.size()) {
 		level = std::make_unique<Level>(*this);
-		level->info = levels[num - 1];
-		if (!level->init()) {
+		if (!_decodeLevel(num, level->info) || !level->init()) {
 			std::cerr << "WARNING: level " << num << " failed to initialize!" << std::endl;
 			level.reset();
 		}
@@ -203,11 +468,118 @@ std::unique_ptr<Level> LevelSet::getLevel(unsigned num) const {
 	return level;
 }
 
+/** Adds the texture and sounds of bullet `bulletId` to `manifest` */
+static void addBullet(lif::AssetManifest& manifest, unsigned bulletId) {
+	const auto data = lif::conf::bullet::data.find(bulletId);
+	if (data == lif::conf::bullet::data.end())
+		return;
+	manifest.addTexture(lif::getAsset("graphics", data->second.filename));
+	manifest.addSound(lif::getAsset("sounds", "bullet" + lif::to_string(bulletId) + "_shot.ogg"));
+	manifest.addSound(lif::getAsset("sounds", "bullet" + lif::to_string(bulletId) + "_hit.ogg"));
+}
+
+lif::AssetManifest LevelSet::getAssetManifest(unsigned num) const {
+	lif::AssetManifest manifest;
+	lif::LevelInfo info;
+	if (num == 0 || num > levelOffsets.size() || !_decodeLevel(num, info))
+		return manifest;
+
+	// Note: this mirrors the assets loaded by the entities' constructors and by LevelLoader
+	const auto graphics = [&manifest] (const std::string& name) {
+		manifest.addTexture(lif::getAsset("graphics", name));
+	};
+	const auto sounds = [&manifest] (const std::string& name) {
+		manifest.addSound(lif::getAsset("sounds", name));
+	};
+
+	graphics("bg" + lif::to_string(info.tileIDs.bg) + ".png");
+	graphics("border" + lif::to_string(info.tileIDs.border) + ".png");
+	manifest.addMusic(info.track.name);
+
+	// Bombs and level events can happen in any level
+	for (auto name : { "bomb.png", "explosionC.png", "explosionH.png", "explosionV.png", "flash.png" })
+		graphics(name);
+	for (auto name : { "explosion.ogg", "fuse.ogg", lif::HURRY_UP_SOUND, lif::GAME_OVER_SOUND,
+			lif::EXTRA_GAME_SOUND, lif::EXTRA_LIFE_SOUND, lif::LEVEL_CLEAR_SOUND, lif::TIME_BONUS_SOUND })
+		sounds(name);
+
+	const auto nTiles = std::min(info.tilemap.size(), std::size_t(info.width * info.height));
+	for (std::size_t i = 0; i < nTiles; ++i) {
+		const auto type = info.tilemap[i];
+		switch (type) {
+		case lif::EntityType::FIXED:
+			graphics("fixed.png");
+			break;
+		case lif::EntityType::BREAKABLE:
+			graphics("breakable.png");
+			sounds("wall_break.ogg");
+			// Breakables may drop bonuses
+			graphics("bonuses.png");
+			sounds("bonus_grab.ogg");
+			break;
+		case lif::EntityType::COIN:
+			graphics("coin.png");
+			sounds("coin.ogg");
+			// Taking all coins triggers EXTRA game
+			graphics("extra_letters.png");
+			sounds("letter_grab.ogg");
+			sounds("alien_death.ogg");
+			break;
+		case lif::EntityType::PLAYER1:
+		case lif::EntityType::PLAYER2:
+			{
+				const auto id = lif::to_string(type == lif::EntityType::PLAYER1 ? 1 : 2);
+				graphics("player" + id + ".png");
+				for (auto snd : { "_death.ogg", "_hurt.ogg", "_win.ogg" })
+					sounds("player" + id + snd);
+				break;
+			}
+		case lif::EntityType::TELEPORT:
+			graphics("teleport.png");
+			sounds("teleport.ogg");
+			break;
+		case lif::EntityType::ALIEN_BOSS:
+			graphics("alien_boss.png");
+			sounds("alienboss_death.ogg");
+			sounds("alienboss_hurt.ogg");
+			addBullet(manifest, 101);
+			break;
+		case lif::EntityType::BIG_ALIEN_BOSS:
+			graphics("big_alien_boss.png");
+			graphics("energy_bar.png");
+			graphics("energy_bar_empty.png");
+			sounds("big_alien_boss_death.ogg");
+			sounds("big_alien_boss_hurt.ogg");
+			// Boss explosions
+			addBullet(manifest, 101);
+			break;
+		default:
+			if (type >= lif::EntityType::ENEMY1 && type <= lif::EntityType::ENEMY10) {
+				const auto id = static_cast<int>(type) - static_cast<int>(lif::EntityType::ENEMY1) + 1;
+				const auto& enemy = getEnemyInfo(id);
+				graphics("enemy" + lif::to_string(id) + ".png");
+				graphics("aliensprite.png");
+				sounds("enemy" + lif::to_string(id) + "_death.ogg");
+				// Only enemies with the first AIs yell (see Enemy's constructor)
+				if (enemy.ai <= 1)
+					sounds("enemy" + lif::to_string(id) + "_yell.ogg");
+				if (enemy.attack.type & lif::AttackType::CONTACT)
+					sounds("enemy" + lif::to_string(id) + "_attack.ogg");
+				else
+					addBullet(manifest, enemy.attack.bulletId);
+			}
+			break;
+		}
+	}
+
+	return manifest;
+}
+
 std::string LevelSet::toString() const {
 	std::stringstream ss;
-	ss << "Level Set: " << metadata.find("name")->second << "\r\n"
+	ss << "Level Set: " << getMeta("name") << "\r\n"
 	   << "Tracks: " << tracks.size() << "\r\n"
-	   << "Levels: " << levels.size() << "\r\n";
+	   << "Levels: " << levelOffsets.size() << "\r\n";
 	for (const auto& pair : metadata) {
 		if (pair.first == "name") continue;
 		ss << pair.first << ": " << pair.second << "\r\n";
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "AssetManifest.hpp"
 #include "Enemy.hpp"
 #include "Level.hpp"
 #include "Stringable.hpp"
 #include "Track.hpp"
 #include <SFML/System/NonCopyable.hpp>
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -16,27 +19,58 @@ namespace lif {
  * A LevelSet groups information about a set of Levels, along with
  * extra info about enemies, music, etc. Basically, it holds the
  * customizable game configuration read from a JSON file.
+ * The JSON is compiled into a compact binary form (see `compile`), which is cached next to it
+ * and from which each level is only decoded when it's requested.
  */
 class LevelSet final : public lif::Stringable, private sf::NonCopyable {
-	std::vector<lif::LevelInfo> levels;
+	/** The compiled levelset */
+	std::vector<char> data;
+	/** The offset in `data` of each level's record */
+	std::vector<std::uint32_t> levelOffsets;
 	std::vector<lif::Track> tracks;
 	std::array<EnemyInfo, lif::N_ENEMIES> enemies;
 	std::unordered_map<std::string, std::string> metadata;
+	/** The hash of the JSON the levelset was loaded from */
+	std::uint32_t sourceHash = 0;
+
+	/** Reads the tables of the compiled levelset in `data`, which was compiled from `jsonPath` */
+	bool _loadTables(const std::string& jsonPath);
+	/** Decodes the i-th level's (starting from 1) record into `info` */
+	bool _decodeLevel(unsigned i, lif::LevelInfo& info) const;
 
 public:
 	LevelSet() {}
-	LevelSet(const std::string& jsonPath);
+	/** Loads the levelset from `jsonPath`. Errors are reported to stderr and leave the LevelSet empty. */
+	explicit LevelSet(const std::string& jsonPath);
 	~LevelSet() {}
 
+	/** Loads the levelset JSON `jsonPath`. If the cache at getCachePath(`jsonPath`) was compiled
+	 *  from the same content, it's loaded from there; otherwise, the JSON is compiled and the
+	 *  cache is (re)written. Errors are reported to stderr.
+	 *  @return Whether the levelset was loaded
+	 */
 	bool loadFromFile(const std::string& jsonPath);
 
 	/** Constructs the i-th level (starting from 1) and returns it if init() is successful. */
 	std::unique_ptr<Level> getLevel(unsigned i) const;
-	unsigned short getLevelsNum() const { return levels.size(); }
+	unsigned short getLevelsNum() const { return levelOffsets.size(); }
+	/** @return The textures, sounds and music used by the i-th level (starting from 1), as far as
+	 *  it can be told from its tilemap and info (empty if there's no such level).
+	 */
+	lif::AssetManifest getAssetManifest(unsigned i) const;
 	std::string getMeta(const std::string& key) const;
 	const EnemyInfo& getEnemyInfo(const int id) const { return enemies[id - 1]; }
+	/** @return An hash of the levelset's JSON content, telling apart different levelsets */
+	std::uint32_t getSourceHash() const { return sourceHash; }
 
 	std::string toString() const override;
+
+	/** Compiles the levelset JSON `jsonPath` into `outPath`. Errors are reported to stderr.
+	 *  @return Whether the compiled levelset was written
+	 */
+	static bool compile(const std::string& jsonPath, const std::string& outPath);
+	/** @return The path where the compiled `jsonPath` is cached */
+	static std::string getCachePath(const std::string& jsonPath);
 };
 
 }
@@ -20,7 +20,7 @@ static bool isMostlyAligned(const lif::Entity& entity) {
 void TeleportSystem::add(lif::Teleport* tp) {
 	teleports.emplace_back(tp);
 	inactiveTime.emplace_back(sf::Time::Zero);
-	justTeleportedTo.emplace_back(std::weak_ptr<lif::Collider>{});
+	justTeleportedTo.emplace_back();
 }
 
 void TeleportSystem::update() {
@@ -56,17 +56,15 @@ void TeleportSystem::_updateActive(unsigned tpIdx) {
 	auto tp = teleports[tpIdx];
 	// Check if there are any entities colliding with this teleport
 	auto collider = tp->get<lif::Collider>();
-	auto colliding = collider->getColliding();
-	std::weak_ptr<lif::Collider> collided;
-	for (auto& cld : colliding) {
-		if (cld.lock() != justTeleportedTo[tpIdx].lock() && !cld.expired()) {
-			collided = cld;
+	lif::Collider *shCollided = nullptr;
+	for (auto cld : collider->getColliding()) {
+		if (cld->getHandle() != justTeleportedTo[tpIdx]) {
+			shCollided = cld;
 			break;
 		}
 	}
 
-	auto shCollided = collided.lock();
-	if (!shCollided)
+	if (shCollided == nullptr)
 		return;
 
 	auto& entity = shCollided->getOwnerRW();
@@ -102,7 +100,7 @@ void TeleportSystem::_updateActive(unsigned tpIdx) {
 	inactiveTime[tpIdx] = COOLDOWN_TIME;
 	inactiveTime[warpToIdx] = COOLDOWN_TIME;
 	if (shCollided->getLayer() == lif::c_layers::PLAYERS)
-		justTeleportedTo[warpToIdx] = collided;
+		justTeleportedTo[warpToIdx] = shCollided->getHandle();
 }
 
 int TeleportSystem::_findNextViable(unsigned startingTp, lif::c_layers::Layer layer) const {
@@ -113,9 +111,8 @@ int TeleportSystem::_findNextViable(unsigned startingTp, lif::c_layers::Layer la
 	const auto good = [this, layer] (unsigned id) {
 		if (inactiveTime[id] > sf::Time::Zero) return false;
 		const auto& cld = teleports[id]->collider->getColliding();
-		return !std::any_of(cld.begin(), cld.end(), [layer] (const auto& wc) {
-			if (auto c = wc.lock()) return c->getLayer() == layer || c->getOwner().isAligned();
-			return false;
+		return !std::any_of(cld.begin(), cld.end(), [layer] (const lif::Collider *c) {
+			return c->getLayer() == layer || c->getOwner().isAligned();
 		});
 	};
 
@@ -134,19 +131,17 @@ int TeleportSystem::_findNextViable(unsigned startingTp, lif::c_layers::Layer la
 
 void TeleportSystem::_updateJustTeleportedTo(unsigned id) {
 	auto& jtt = justTeleportedTo[id];
-	if (jtt.expired())
+	if (jtt.isNull())
 		return;
 
-	for (auto cld : teleports[id]->collider->getColliding()) {
-		if (auto c = cld.lock()) {
-			if (c == jtt.lock() && isMostlyAligned(c->getOwner())) {
-				return;
-			}
+	for (auto c : teleports[id]->collider->getColliding()) {
+		if (c->getHandle() == jtt && isMostlyAligned(c->getOwner())) {
+			return;
 		}
 	}
 
 	// If the saved entity does not collide with the teleport anymore, reset it.
-	jtt.reset();
+	jtt = lif::Handle<lif::Collider>();
 }
 
 void TeleportSystem::clear() {
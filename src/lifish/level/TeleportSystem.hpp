@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Handle.hpp"
 #include "collision_layers.hpp"
 #include <SFML/System.hpp>
 #include <memory>
@@ -15,7 +16,7 @@ class TeleportSystem final {
 	std::vector<lif::Teleport*> teleports;
 	/** Countdown to activation. If Zero, the teleport is active. */
 	std::vector<sf::Time> inactiveTime;
-	std::vector<std::weak_ptr<lif::Collider>> justTeleportedTo;
+	std::vector<lif::Handle<lif::Collider>> justTeleportedTo;
 
 	void _updateActive(unsigned id);
 	void _updateJustTeleportedTo(unsigned id);
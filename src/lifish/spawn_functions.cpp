@@ -6,7 +6,6 @@
 #include "EnemyFactory.hpp"
 #include "utils.hpp"
 #include "collision_utils.hpp"
-#include <random>
 #include "game.hpp"
 
 void lif::spawnInFreeTiles(lif::BufferedSpawner *spawner, lif::LevelManager& lm,
@@ -30,9 +29,13 @@ void lif::spawnInFreeTiles(lif::BufferedSpawner *spawner, lif::LevelManager& lm,
 		return false;
 	}), viablePositions.end());
 
-	std::uniform_int_distribution<> dist(0, viablePositions.size() - 1);
+	if (viablePositions.size() == 0)
+		return;
+
+	auto& random = spawner->getRandom();
 	for (int i = 0; i < nSpawned; ++i) {
-		const auto pos = sf::Vector2f(viablePositions[dist(lif::rng)] * lif::TILE_SIZE);
+		const auto pos = sf::Vector2f(viablePositions[random.nextInt(0, viablePositions.size() - 1)]
+				* lif::TILE_SIZE);
 		auto enemy = lif::EnemyFactory::create(lm, spawnedEnemyId, pos);
 		if (cb)
 			cb(enemy.get());
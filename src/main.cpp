@@ -59,6 +59,8 @@ struct MainArgs {
 	bool muteSounds = false;
 	bool muteMusic = false;
 	int fps = -1;
+	int simRate = -1;
+	int updateThreads = -1;
 #ifndef RELEASE
 	bool startFromHome = false;
 #endif
@@ -96,6 +98,18 @@ static void parseArgs(int argc, char **argv, /* out */ MainArgs& args) {
 				else
 					std::cerr << "[ WARNING ] Expected numeral after -f flag" << std::endl;
 				break;
+			case 'r':
+				if (i < argc - 1)
+					args.simRate = std::atoi(argv[++i]);
+				else
+					std::cerr << "[ WARNING ] Expected numeral after -r flag" << std::endl;
+				break;
+			case 'j':
+				if (i < argc - 1)
+					args.updateThreads = std::atoi(argv[++i]);
+				else
+					std::cerr << "[ WARNING ] Expected numeral after -j flag" << std::endl;
+				break;
 #ifndef RELEASE
 			case 'u':
 				args.startFromHome = true;
@@ -109,12 +123,14 @@ static void parseArgs(int argc, char **argv, /* out */ MainArgs& args) {
 				break;
 			default:
 				std::cout << "Usage: " << argv[0]
-				          << " [-l <levelnum>] [-v] [-f <fps>] [levelset.json]\r\n"
+				          << " [-l <levelnum>] [-v] [-f <fps>] [-r <rate>] [-j <threads>] [levelset.json]\r\n"
 				          << "\t-l: start at level <levelnum>\r\n"
 				          << "\t-i: print info about <levelset.json> and exit\r\n"
 				          << "\t-s: start with sounds muted\r\n"
 				          << "\t-m: start with music muted\r\n"
 				          << "\t-f: set framerate limit to <fps>\r\n"
+				          << "\t-r: step the simulation <rate> times per second (0: once per frame)\r\n"
+				          << "\t-j: update the entities with <threads> threads (0: as many as the CPU has)\r\n"
 #ifndef RELEASE
 				          << "\t-u: start in the home screen, not in game\r\n"
 #endif
@@ -128,16 +144,15 @@ static void parseArgs(int argc, char **argv, /* out */ MainArgs& args) {
 	}
 
 	if (print_level_info) {
-		try {
-			lif::LevelSet ls(args.levelsetName);
-			std::cout << "--------------\r\nLevelset info:\r\n--------------\r\n"
-				<< ls.toString() << std::endl;
-			std::exit(0);
-		} catch (const std::exception&) {
+		lif::LevelSet ls;
+		if (!ls.loadFromFile(args.levelsetName)) {
 			std::cerr << "Error: file \"" << args.levelsetName
 				<< "\" not found or with wrong format." << std::endl;
 			std::exit(1);
 		}
+		std::cout << "--------------\r\nLevelset info:\r\n--------------\r\n"
+			<< ls.toString() << std::endl;
+		std::exit(0);
 	}
 }
 
@@ -234,6 +249,10 @@ int main(int argc, char **argv) {
 	lif::options.vsync = true;
 	if (args.fps >= 0)
 		lif::options.framerateLimit = args.fps;
+	if (args.simRate >= 0)
+		lif::options.simulationRate = args.simRate;
+	if (args.updateThreads >= 0)
+		lif::options.updateThreads = args.updateThreads;
 
 	sf::RenderWindow window;
 	createRenderWindow(window);
@@ -246,6 +265,14 @@ int main(int argc, char **argv) {
 	// Setup icon
 	loadIcon(window);
 
+	// Pack the entities' sprite sheets together, so that LevelRenderer can batch their drawing
+	{
+		std::vector<std::string> atlasTextures;
+		for (auto name : lif::ATLAS_TEXTURES)
+			atlasTextures.emplace_back(lif::getAsset("graphics", name));
+		lif::cache.buildAtlas(atlasTextures);
+	}
+
 	// Setup UI
 	auto& ui = lif::ui::UI::getInstance();
 	setupUI(ui, window);
@@ -290,9 +317,13 @@ int main(int argc, char **argv) {
 	bool wasVSync = lif::options.vsync;
 	sf::VideoMode curVideoMode = lif::options.videoMode;
 
+	lif::time.setFixedStep(lif::options.simulationRate > 0
+			? sf::seconds(1.f / lif::options.simulationRate)
+			: sf::Time::Zero);
+
 	while (!lif::terminated) {
 
-		lif::time.update();
+		lif::time.beginFrame();
 
 		///// EVENT LOOP /////
 
@@ -319,15 +350,25 @@ int main(int argc, char **argv) {
 
 		///// LOGIC LOOP /////
 
-		cur_context->update();
+		// Step the simulation as many times as due since the last frame. The rendering will then
+		// interpolate between the last two steps (see lif::Time::getAlpha).
+		while (lif::time.nextStep()) {
+			cur_context->update();
 #ifndef RELEASE
-		fadeoutTextMgr.update();
+			fadeoutTextMgr.update();
 #endif
+			// Let the context switch happen before running more steps
+			if (cur_context->getNewContext() >= 0)
+				break;
+		}
+
+		// Move the assets loaded in background into the cache, without stalling the frame
+		lif::cache.uploadPending(sf::milliseconds(2));
 
 		///// RENDERING LOOP //////
 
 #ifndef RELEASE
-		dbgStats.timer.start("draw");
+		dbgStats.timer.start(LIF_ZONE_ID("draw"));
 #endif
 		window.clear();
 		window.draw(*cur_context);
@@ -345,15 +386,25 @@ int main(int argc, char **argv) {
 		window.display();
 
 #ifndef RELEASE
-		dbgStats.timer.end("draw");
+		dbgStats.timer.end(LIF_ZONE_ID("draw"));
 		++cycle;
 		if (lif::options.printDrawStats && cycle % 50 == 0) {
 			std::ios::fmtflags flags(std::cout.flags());
 			std::cout //<< std::setfill(' ') << std::scientific << std::setprecision(4)
 				<< ">> Draw: " << std::setw(6) << dbgStats.timer.safeGet("draw") * 1000
-				<< " ms" << std::endl;
+				<< " ms";
+			if (game)
+				std::cout << " (level: " << game->getLM().getRenderer().getDrawCalls() << " draw calls)";
+			std::cout << std::endl;
 			std::cout.flags(flags);
 		}
+		if (lif::options.printCacheStats && cycle % 50 == 0) {
+			const auto stats = lif::cache.getStats();
+			std::cout << ">> Cache: " << stats.textures << " textures, " << stats.sounds << " sounds, "
+				<< stats.fonts << " fonts | GPU: " << stats.gpuBytes / 1024 << " KiB, CPU: "
+				<< stats.cpuBytes / 1024 << " KiB | hits: " << stats.hits << ", misses: " << stats.misses
+				<< ", evictions: " << stats.evictions << std::endl;
+		}
 #endif
 
 		// Handle fullscreen
@@ -0,0 +1,65 @@
+/*!
+ * Lifish asset packer
+ * @copyright 2017, Giacomo Parolini
+ *
+ * Packs the textures, sounds and fonts under the assets directory into a single archive
+ * (see AssetArchive). When the game finds the archive next to its executable, it loads
+ * those assets from there rather than from the loose files.
+ *
+ * This game is licensed under the Lifish License, available at
+ * https://silverweed.github.io/lifish-license.txt
+ * or in the LICENSE file in this repository's root directory.
+*/
+#include "AssetArchive.hpp"
+#include "GameCache.hpp"
+#include "core.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+	if (!lif::initCore()) {
+		std::cerr << "Failed to initialize!" << std::endl;
+		return 1;
+	}
+	// Unmap the current archive, if any, before overwriting it
+	lif::cache.finalize();
+
+	std::string outPath = std::string(lif::pwd) + lif::DIRSEP + lif::ASSET_ARCHIVE_NAME;
+	std::string assetDir = lif::getAssetDir();
+	std::vector<std::string> subdirs;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg(argv[i]);
+		if (arg == "-o" && i < argc - 1) {
+			outPath = argv[++i];
+		} else if (arg == "-a" && i < argc - 1) {
+			assetDir = argv[++i];
+			if (assetDir.back() != lif::DIRSEP)
+				assetDir += lif::DIRSEP;
+		} else if (arg[0] == '-') {
+			std::cout << "Usage: " << argv[0] << " [-a <assets dir>] [-o <out.pak>] [subdir...]\r\n"
+			          << "\t-a: the directory to pack (default: the game's assets directory)\r\n"
+			          << "\t-o: the archive to write (default: " << lif::ASSET_ARCHIVE_NAME
+			          << " next to the game)\r\n"
+			          << "\tsubdir: the subdirectories to pack (default: graphics sounds fonts)" << std::endl;
+			return 1;
+		} else {
+			subdirs.emplace_back(arg);
+		}
+	}
+	// Music is streamed and the other assets are not loaded via the GameCache
+	if (subdirs.empty())
+		subdirs = { "graphics", "sounds", "fonts" };
+
+	if (!lif::AssetArchive::pack(assetDir, subdirs, outPath))
+		return 1;
+
+	lif::AssetArchive archive;
+	if (!archive.open(outPath, assetDir)) {
+		std::cerr << "Failed to read back " << outPath << std::endl;
+		return 1;
+	}
+	std::cout << "Packed " << archive.getEntriesCount() << " files into " << outPath << std::endl;
+
+	return 0;
+}
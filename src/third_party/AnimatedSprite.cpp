@@ -193,6 +193,20 @@ void AnimatedSprite::update(sf::Time deltaTime)
     }
 }
 
+const sf::Texture* AnimatedSprite::getQuad(sf::Vertex *quad) const
+{
+    if (!m_animation || !m_texture)
+        return nullptr;
+
+    const auto& transform = getTransform();
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        quad[i] = m_vertices[i];
+        quad[i].position = transform.transformPoint(m_vertices[i].position);
+    }
+    return m_texture;
+}
+
 void AnimatedSprite::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
     if (m_animation && m_texture)
@@ -27,6 +27,7 @@
 #define ANIMATEDSPRITE_INCLUDE
 
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Transformable.hpp>
@@ -58,6 +59,9 @@ public:
     sf::Time getFrameTime() const;
     void setFrame(std::size_t newFrame, bool resetTime = true);
     std::size_t getCurrentFrame() const;
+    /// Writes the transformed vertices of the current frame into `quad` and returns the texture
+    /// to draw them with, or nullptr if there's nothing to draw.
+    const sf::Texture* getQuad(sf::Vertex *quad) const;
 
 private:
     const Animation* m_animation;
@@ -71,6 +71,9 @@ SidePanel::SidePanel(const lif::LevelManager& lm)
 			}
 		}
 	}
+
+	font = lif::cache.loadFont(lif::getAsset("fonts", lif::fonts::SIDE_PANEL));
+	thinFont = lif::cache.loadFont(lif::getAsset("fonts", lif::fonts::SIDE_PANEL_THIN));
 }
 
 static void _drawWithShadow(sf::RenderTarget& window, sf::RenderStates states, const sf::Sprite& sprite) {
@@ -134,9 +137,7 @@ void SidePanel::_drawTime(sf::RenderTarget& window, sf::RenderStates states) con
 		ss << seconds;
 	}
 
-	lif::ShadedText timeText(
-			lif::getAsset("fonts", lif::fonts::SIDE_PANEL),
-			ss.str(), TIME_POS);
+	lif::ShadedText timeText(*font, ss.str(), TIME_POS);
 	timeText.setCharacterSize(28);
 	timeText.setShadowSpacing(2, 2);
 	if (minutes < 1 && seconds <= 30) {
@@ -162,7 +163,7 @@ void SidePanel::draw(sf::RenderTarget& window, sf::RenderStates states) const {
 			ss << "X" << (player->getInfo().remainingLives + 1);
 		}
 
-		lif::ShadedText text(lif::getAsset("fonts", lif::fonts::SIDE_PANEL), ss.str(), pos);
+		lif::ShadedText text(*font, ss.str(), pos);
 		text.setCharacterSize(32);
 		text.setShadowSpacing(2, 2);
 		window.draw(text, states);
@@ -212,16 +213,14 @@ void SidePanel::draw(sf::RenderTarget& window, sf::RenderStates states) const {
 		// Draw score
 		pos.x = SCORE_POS_X;
 		pos.y = i == 0 ? SCORE_POS_Y_1 : SCORE_POS_Y_2;
-		lif::ShadedText scoreText(
-				lif::getAsset("fonts", lif::fonts::SIDE_PANEL),
-				"score", pos + sf::Vector2f(3, -38));
+		lif::ShadedText scoreText(*font, "score", pos + sf::Vector2f(3, -38));
 		scoreText.setCharacterSize(32);
 		scoreText.setShadowSpacing(2, 2);
 		window.draw(scoreText, states);
 		ss.str("");
 		ss << std::setfill('0') << std::setw(6) << lm.getScore(i + 1);
 		//scoreText.setCharacterSize(16);
-		scoreText.setFont(*lif::cache.loadFont(lif::getAsset("fonts", lif::fonts::SIDE_PANEL_THIN)));
+		scoreText.setFont(*thinFont);
 		scoreText.setPosition(pos);
 		scoreText.setString(ss.str());
 		window.draw(scoreText, states);
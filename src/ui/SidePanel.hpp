@@ -82,6 +82,10 @@ class SidePanel final : public sf::Drawable, private sf::NonCopyable {
 	/** The Bonus icons */
 	Matrix<sf::Sprite, lif::MAX_PLAYERS, lif::conf::bonus::N_PERMANENT_BONUS_TYPES> bonusesSprite;
 
+	/** The fonts of the texts, looked up once rather than at every draw */
+	const sf::Font *font;
+	const sf::Font *thinFont;
+
 	void _drawHealthSprites(sf::RenderTarget& window, sf::RenderStates states,
 			const lif::Player& player) const;
 	void _drawExtraLetters(sf::RenderTarget& window, sf::RenderStates states,